@@ -0,0 +1,309 @@
+/**
+ * @file function_bench.cpp
+ * @brief Google Benchmark suite for NekoFunction library
+ * @author moehoshio
+ *
+ * Run with --benchmark_out=result.json --benchmark_out_format=json to keep a
+ * JSON report, and compare two reports with benchmark's tools/compare.py.
+ */
+
+#include <benchmark/benchmark.h>
+#include <neko/function/base64.hpp>
+#include <neko/function/detectFileType.hpp>
+#include <neko/function/hash.hpp>
+#include <neko/function/pattern.hpp>
+#include <neko/function/utilities.hpp>
+#include <neko/function/uuid.hpp>
+
+#ifdef NEKO_FUNCTION_ENABLE_ARCHIVE
+#include <neko/function/archive.hpp>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+    namespace stdfs = std::filesystem;
+    namespace hash = neko::util::hash;
+
+    /**
+     * @brief Deterministic pseudo-random content, so runs compare across versions.
+     */
+    std::string makeData(std::size_t size, std::uint32_t seed = 42) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<int> dist(0, 255);
+        std::string data(size, '\0');
+        for (auto &c : data) {
+            c = static_cast<char>(dist(gen));
+        }
+        return data;
+    }
+
+    /**
+     * @brief Scratch directory under the system temp path, removed on destruction.
+     */
+    class TempDir {
+    public:
+        explicit TempDir(const std::string &name)
+            : path(stdfs::temp_directory_path() / ("neko_function_bench_" + name)) {
+            stdfs::remove_all(path);
+            stdfs::create_directories(path);
+        }
+        ~TempDir() {
+            std::error_code ec;
+            stdfs::remove_all(path, ec);
+        }
+        TempDir(const TempDir &) = delete;
+        TempDir &operator=(const TempDir &) = delete;
+
+        stdfs::path path;
+    };
+
+    void writeFile(const stdfs::path &path, const std::string &content) {
+        stdfs::create_directories(path.parent_path());
+        std::ofstream out(path, std::ios::binary);
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+
+    // Exclude list shaped like a typical project packaging config
+    const std::vector<std::string> &excludePatterns() {
+        static const std::vector<std::string> patterns = {
+            ".git/", "node_modules/", "build/", "_build/", "out/", ".cache/",
+            "*.o", "*.obj", "*.pdb", "*.tmp", "*.log", "*.swp", "*~",
+            "Thumbs.db", ".DS_Store", "logs/*.log", "**/generated/**",
+            "^.*\\.bak$", "/opt/project/secret.key"};
+        return patterns;
+    }
+
+    const std::vector<std::string> &samplePaths() {
+        static const std::vector<std::string> paths = {
+            "src/neko/function/archiveZip.cpp", "include/neko/function/hash.hpp",
+            "build/CMakeFiles/main.o", "assets/textures/stone.png", "logs/2025-01-01.log",
+            "docs/api/generated/index.html", "README.md", "config/settings.json.bak",
+            "node_modules/pkg/index.js", "tests/function_test.cpp"};
+        return paths;
+    }
+
+} // namespace
+
+// ============================================================================
+// Hash
+// ============================================================================
+
+static void BM_HashDigest(benchmark::State &state, hash::Algorithm algorithm) {
+    const auto data = makeData(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hash::digest(data, algorithm));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_HashDigest, crc32, hash::Algorithm::crc32)->Range(64, 16 << 20);
+BENCHMARK_CAPTURE(BM_HashDigest, xxh3_64, hash::Algorithm::xxh3_64)->Range(64, 16 << 20);
+BENCHMARK_CAPTURE(BM_HashDigest, blake3, hash::Algorithm::blake3)->Range(64, 16 << 20);
+#ifdef NEKO_FUNCTION_ENABLE_HASH
+BENCHMARK_CAPTURE(BM_HashDigest, md5, hash::Algorithm::md5)->Range(64, 16 << 20);
+BENCHMARK_CAPTURE(BM_HashDigest, sha256, hash::Algorithm::sha256)->Range(64, 16 << 20);
+#endif
+
+static void BM_HashDigestFile(benchmark::State &state, hash::Algorithm algorithm) {
+    TempDir dir("digest_file");
+    const auto file = (dir.path / "data.bin").string();
+    writeFile(file, makeData(static_cast<std::size_t>(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hash::digestFile(file, algorithm));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK_CAPTURE(BM_HashDigestFile, xxh3_64, hash::Algorithm::xxh3_64)->Range(4 << 10, 64 << 20);
+#ifdef NEKO_FUNCTION_ENABLE_HASH
+BENCHMARK_CAPTURE(BM_HashDigestFile, sha256, hash::Algorithm::sha256)->Range(4 << 10, 64 << 20);
+#endif
+
+// ============================================================================
+// Base64
+// ============================================================================
+
+static void BM_Base64Encode(benchmark::State &state) {
+    const auto data = makeData(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(neko::util::base64::encode(data));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Base64Encode)->Range(16, 4 << 20);
+
+static void BM_Base64Decode(benchmark::State &state) {
+    const auto encoded = neko::util::base64::encode(makeData(static_cast<std::size_t>(state.range(0))));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(neko::util::base64::decode(encoded));
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Base64Decode)->Range(16, 4 << 20);
+
+// ============================================================================
+// Pattern
+// ============================================================================
+
+static void BM_PatternMatchAny(benchmark::State &state) {
+    const auto &patterns = excludePatterns();
+    const auto &paths = samplePaths();
+    for (auto _ : state) {
+        for (const auto &path : paths) {
+            benchmark::DoNotOptimize(neko::util::pattern::matchAny(path, patterns));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * paths.size()));
+}
+BENCHMARK(BM_PatternMatchAny);
+
+static void BM_PatternCompiledSet(benchmark::State &state) {
+    const neko::util::pattern::CompiledPatternSet set(excludePatterns());
+    const auto &paths = samplePaths();
+    for (auto _ : state) {
+        for (const auto &path : paths) {
+            benchmark::DoNotOptimize(set.match(path));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * paths.size()));
+}
+BENCHMARK(BM_PatternCompiledSet);
+
+// ============================================================================
+// File type detection
+// ============================================================================
+
+static void BM_DetectFileType(benchmark::State &state) {
+    TempDir dir("detect");
+    const std::string png("\x89PNG\r\n\x1a\n\0\0\0\rIHDR", 16);
+    const std::vector<std::string> files = {
+        (dir.path / "image.png").string(), (dir.path / "notes.txt").string(), (dir.path / "blob.bin").string()};
+    writeFile(files[0], png + makeData(4096));
+    writeFile(files[1], std::string(4096, 'a'));
+    writeFile(files[2], makeData(4096));
+    for (auto _ : state) {
+        for (const auto &file : files) {
+            benchmark::DoNotOptimize(neko::util::detect::detectFileType(file, true));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * files.size()));
+}
+BENCHMARK(BM_DetectFileType);
+
+// ============================================================================
+// UUID & Time
+// ============================================================================
+
+static void BM_UuidV4(benchmark::State &state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(neko::util::uuid::uuidV4());
+    }
+}
+BENCHMARK(BM_UuidV4);
+
+#ifdef NEKO_FUNCTION_ENABLE_HASH
+static void BM_UuidV3(benchmark::State &state) {
+    const std::string name = "www.example.com";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(neko::util::uuid::uuidV3(name));
+    }
+}
+BENCHMARK(BM_UuidV3);
+#endif
+
+static void BM_ParseToUTCTime(benchmark::State &state) {
+    const std::vector<std::string> inputs = {
+        "2025-01-01T00:00:00Z", "2023-06-14T12:34:56.789Z", "1999-12-31T23:59:59+09:00"};
+    for (auto _ : state) {
+        for (const auto &input : inputs) {
+            benchmark::DoNotOptimize(neko::util::time::parseToUTCTime(input));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * inputs.size()));
+}
+BENCHMARK(BM_ParseToUTCTime);
+
+// ============================================================================
+// Archive
+// ============================================================================
+
+#ifdef NEKO_FUNCTION_ENABLE_ARCHIVE
+
+namespace {
+
+    /**
+     * @brief Writes a synthetic tree: range(0) files of range(1) bytes, spread over a few directories.
+     * Half of the files are text so deflate has work to do.
+     */
+    void makeTree(const stdfs::path &root, std::int64_t files, std::int64_t size) {
+        for (std::int64_t i = 0; i < files; ++i) {
+            auto dir = root / ("dir" + std::to_string(i % 8)) / ("sub" + std::to_string(i % 3));
+            auto content = (i % 2 == 0) ? std::string(static_cast<std::size_t>(size), static_cast<char>('a' + i % 26))
+                                        : makeData(static_cast<std::size_t>(size), static_cast<std::uint32_t>(i));
+            writeFile(dir / ("file" + std::to_string(i) + ".dat"), content);
+        }
+    }
+
+} // namespace
+
+static void BM_ZipCreate(benchmark::State &state) {
+    TempDir dir("zip_create");
+    const auto tree = dir.path / "tree";
+    makeTree(tree, state.range(0), state.range(1));
+
+    neko::archive::CreateConfig config;
+    config.outputArchivePath = (dir.path / "out.zip").string();
+    config.inputPaths = {tree.string()};
+    config.threads = static_cast<std::size_t>(state.range(2));
+    for (auto _ : state) {
+        auto summary = neko::archive::zip::create(config);
+        benchmark::DoNotOptimize(summary);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_ZipCreate)
+    ->Args({64, 16 << 10, 1})
+    ->Args({64, 16 << 10, 4})
+    ->Args({8, 1 << 20, 1})
+    ->Args({8, 1 << 20, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_ZipExtract(benchmark::State &state) {
+    TempDir dir("zip_extract");
+    const auto tree = dir.path / "tree";
+    makeTree(tree, state.range(0), state.range(1));
+
+    neko::archive::CreateConfig create;
+    create.outputArchivePath = (dir.path / "in.zip").string();
+    create.inputPaths = {tree.string()};
+    neko::archive::zip::create(create);
+
+    neko::archive::ExtractConfig config;
+    config.inputArchivePath = create.outputArchivePath;
+    config.destDir = (dir.path / "out").string();
+    config.threads = static_cast<std::size_t>(state.range(2));
+    for (auto _ : state) {
+        auto summary = neko::archive::zip::extract(config);
+        benchmark::DoNotOptimize(summary);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) * state.range(0) * state.range(1));
+}
+BENCHMARK(BM_ZipExtract)
+    ->Args({64, 16 << 10, 1})
+    ->Args({64, 16 << 10, 4})
+    ->Args({8, 1 << 20, 1})
+    ->Args({8, 1 << 20, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+#endif // NEKO_FUNCTION_ENABLE_ARCHIVE
+
+BENCHMARK_MAIN();
@@ -16,10 +16,22 @@
 #endif
 
 #include <neko/function/detectFileType.hpp>
+#include <neko/function/pattern.hpp>
 #include <neko/schema/exception.hpp>
+#include <neko/schema/types.hpp>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <future>
 #include <memory>
+#include <span>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #endif
 
@@ -37,6 +49,82 @@ namespace neko::archive {
         ZipCrypto,
         AES256
     };
+
+    enum class OverwritePolicy {
+        never,    // Keep existing files
+        always,   // Rewrite existing files
+        ifChanged // Rewrite only files whose size or CRC-32 differs from the entry
+    };
+
+    /**
+     * @class OverwriteSetting
+     * @brief Type of ExtractConfig::overwrite, which was a bool before OverwritePolicy existed.
+     * Assigning a bool still compiles: true maps to OverwritePolicy::always, false to OverwritePolicy::never.
+     */
+    class OverwriteSetting {
+    public:
+        constexpr OverwriteSetting(OverwritePolicy policy = OverwritePolicy::always) noexcept : value(policy) {}
+        constexpr OverwriteSetting(bool overwrite) noexcept : value(overwrite ? OverwritePolicy::always : OverwritePolicy::never) {}
+
+        constexpr OverwritePolicy policy() const noexcept {
+            return value;
+        }
+        constexpr operator OverwritePolicy() const noexcept {
+            return value;
+        }
+        // As the former bool: whether existing files may be rewritten at all
+        explicit constexpr operator bool() const noexcept {
+            return value != OverwritePolicy::never;
+        }
+
+    private:
+        OverwritePolicy value;
+    };
+    /**
+     * @struct EntryEvent
+     * @brief Describes one entry as it starts or finishes processing.
+     */
+    struct EntryEvent {
+        std::string_view name;                // Entry name inside the archive
+        std::int64_t compressedSize = 0;      // Stored size; when creating, the archive bytes written for the entry (0 on start)
+        std::int64_t uncompressedSize = 0;    // Original size of the content
+        std::chrono::nanoseconds elapsed{0}; // Time spent on the entry (0 on start)
+    };
+
+    /**
+     * @struct ArchiveObserver
+     * @brief Optional callbacks for archive operations.
+     * Calls are serialized, even when entries are processed on several threads.
+     * Returning false from a callback cancels the operation.
+     */
+    struct ArchiveObserver {
+        std::function<bool(const EntryEvent &)> onEntryStart;
+        std::function<bool(const EntryEvent &)> onEntryFinish;
+    };
+
+    /**
+     * @struct ArchiveSummary
+     * @brief Totals of a completed or cancelled archive operation.
+     * codecTime and ioTime are summed over all threads, so with several threads they can exceed elapsed.
+     */
+    struct ArchiveSummary {
+        std::size_t entries = 0;              // Entries finished
+        std::uint64_t compressedBytes = 0;    // Sum of EntryEvent::compressedSize
+        std::uint64_t uncompressedBytes = 0;  // Sum of EntryEvent::uncompressedSize
+        std::chrono::nanoseconds elapsed{0}; // Wall time of the whole operation
+        std::chrono::nanoseconds codecTime{0}; // Reading and inflating, or reading and deflating
+        std::chrono::nanoseconds ioTime{0};    // Writing extracted files, or copying compressed entries into the archive
+        bool cancelled = false;
+
+        /**
+         * @brief Uncompressed throughput over the wall time.
+         */
+        double bytesPerSecond() const noexcept {
+            auto seconds = std::chrono::duration<double>(elapsed).count();
+            return seconds > 0 ? static_cast<double>(uncompressedBytes) / seconds : 0.0;
+        }
+    };
+
     /**
      * @struct CreateConfig
      * @brief Configuration for creating an archive.
@@ -61,8 +149,11 @@ namespace neko::archive {
          *    - Absolute path starting with '/' and ending with '/': Matches only if the full path is exactly the same.
          *    - Relative path (e.g., "logs/"): Matches any folder named "logs" at any level in the path.
          * 5. Wildcards (e.g., "*.txt", "logs/*.log"):
-         *    Supports '*' as a wildcard for any characters.
-         *    - Example: "logs/*.log" matches all ".log" files under the "logs/" folder.
+         *    Read as selected by wildcardMode. By default only '*' is special, as in earlier versions:
+         *    after a relative folder the wildcard matches the next path component and everything below a match,
+         *    after an absolute folder it matches the file name at any depth.
+         *    WildcardMode::glob enables '**', '?' and '[abc]' (see util::pattern::Glob).
+         *    - Example: "logs/*.log" matches the ".log" files directly inside any "logs/" folder.
          * 6. Regular expressions (e.g., "^logs/.*\\.log$"):
          *    Supports regex matching.
          *    - Example: "^logs/.*\\.log$" matches all ".log" files under the "logs/" folder.
@@ -76,14 +167,62 @@ namespace neko::archive {
          */
         std::vector<std::string> excludePaths;
 
+        /**
+         * @brief How wildcards in the path filters are read.
+         * legacy, the default, keeps the matching of earlier versions, so existing filters select the same files.
+         * glob matches each path segment on its own and adds '**', '?' and '[abc]'.
+         */
+        util::pattern::WildcardMode wildcardMode = util::pattern::WildcardMode::legacy;
+
+        /**
+         * @brief Deflate level applied to every entry.
+         * none stores entries uncompressed; maximum and ultra both map to the best deflate level.
+         */
         CompressionLevel compressionLevel = CompressionLevel::normal;
         ZipEncryption encryption = ZipEncryption::AES256;
+
+        /**
+         * @brief Whether inputs that are already compressed (PNG, JPEG, OGG, ZIP/JAR, GZ, ...) are stored without deflate.
+         * The type is taken from util::detect::detectFileType. Deflating such files costs CPU time and rarely saves space.
+         */
+        bool storeCompressedInputs = true;
+
+        /**
+         * @brief Number of threads used to compress entries.
+         * Workers compress files into memory and the compressed streams are written into the archive in input order,
+         * so the entry order does not depend on the thread count. 1 compresses serially, 0 uses the hardware concurrency.
+         */
+        std::size_t threads = 1;
+
+        /**
+         * @brief Whether to rebuild the archive incrementally from the previous run.
+         * A manifest (entry name, size, mtime and CRC of each source file) is kept next to the archive.
+         * Files whose size and mtime, or size and CRC, match the manifest are copied raw from the previous archive
+         * without recompression; only new and changed files are compressed. Changing compressionLevel,
+         * storeCompressedInputs or the encryption mode discards the manifest. A changed password is not detected,
+         * so remove the manifest when changing it.
+         */
+        bool incremental = false;
+
+        /**
+         * @brief Path of the manifest used by incremental mode. Empty uses outputArchivePath + ".manifest".
+         */
+        std::string manifestPath;
+
+        /**
+         * @brief Progress callbacks; an entry's compressedSize includes its headers.
+         */
+        ArchiveObserver observer;
+        /**
+         * @brief Cancels the operation when a stop is requested. A cancelled archive is removed.
+         */
+        std::stop_token stopToken;
     };
 
     struct ExtractConfig {
         std::string
             inputArchivePath, // Extract data from this archive file
-            destDir,          // Extract the archive to this directory
+            destDir,          // Extract the archive to this directory, UTF-8 like the entry names
             password;         // Password for extraction (optional)
 
         /**
@@ -98,8 +237,11 @@ namespace neko::archive {
          *   - Absolute path starting with '/' and ending with '/': Matches only if the full path is exactly the same.
          *   - Relative path (e.g., "logs/"): Matches any folder named "logs" at any level in the path.
          * 5. Wildcards (e.g., "*.txt", "logs/*.log"):
-         *   Supports '*' as a wildcard for any characters.
-         *   - Example: "logs/*.log" matches all ".log" files under the "logs/" folder.
+         *   Read as selected by wildcardMode. By default only '*' is special, as in earlier versions:
+         *   after a relative folder the wildcard matches the next path component and everything below a match,
+         *   after an absolute folder it matches the file name at any depth.
+         *   WildcardMode::glob enables '**', '?' and '[abc]' (see util::pattern::Glob).
+         *   - Example: "logs/*.log" matches the ".log" files directly inside any "logs/" folder.
          * 6. Regular expressions (e.g., "^logs/.*\\.log$"):
          *   Supports regex matching.
          *   - Example: "^logs/.*\\.log$" matches all ".log" files under the "logs/" folder.
@@ -115,18 +257,80 @@ namespace neko::archive {
         std::vector<std::string> excludePaths;
 
         /**
-         * @brief Whether to overwrite existing files during extraction.
-         * If true, existing files will be overwritten.
-         * If false, existing files will be skipped.
+         * @brief How wildcards in the path filters are read.
+         * legacy, the default, keeps the matching of earlier versions, so existing filters select the same files.
+         * glob matches each path segment on its own and adds '**', '?' and '[abc]'.
+         */
+        util::pattern::WildcardMode wildcardMode = util::pattern::WildcardMode::legacy;
+
+        /**
+         * @brief How existing files are handled during extraction.
+         * ifChanged compares the entry's uncompressed size with the file size first, then its stored CRC-32
+         * with the file content, and skips identical files without inflating them.
+         * A bool is also accepted, as in earlier versions: true is always, false is never.
          */
-        bool overwrite = true;
+        OverwriteSetting overwrite = OverwritePolicy::always;
+
+        /**
+         * @brief Number of threads used to decompress entries.
+         * The central directory is read once, then file entries are split across workers,
+         * each with its own reader handle on the archive. 1 extracts serially, 0 uses the hardware concurrency.
+         */
+        std::size_t threads = 1;
+
+        /**
+         * @brief Progress callbacks, not called for files skipped by the overwrite policy.
+         */
+        ArchiveObserver observer;
+        /**
+         * @brief Cancels the operation when a stop is requested. Files already extracted are kept,
+         * a partially written file is removed.
+         */
+        std::stop_token stopToken;
+    };
+
+    /**
+     * @struct MemoryFile
+     * @brief A named buffer to be written into an archive.
+     * The data is referenced, not copied, and must stay valid while the archive is created.
+     */
+    struct MemoryFile {
+        std::string name;                 // Entry name inside the archive, e.g. "assets/logo.png"
+        std::span<const neko::uchar> data; // Uncompressed content
+    };
+
+    /**
+     * @struct MemoryEntry
+     * @brief An entry extracted from an archive into memory.
+     */
+    struct MemoryEntry {
+        std::string name;              // Entry name inside the archive
+        std::vector<neko::uchar> data; // Uncompressed content
     };
 
+    /**
+     * @brief Receives the decompressed content of one entry, called repeatedly with consecutive chunks.
+     * Every entry is reported with at least one call, so empty entries yield one empty chunk.
+     */
+    using EntrySink = std::function<void(std::string_view name, std::span<const neko::uchar> chunk)>;
+
+    /**
+     * @brief Pulls archive bytes from the caller.
+     * Fills up to size bytes into buffer and returns the number of bytes written; 0 signals the end of the data.
+     */
+    using ReadCallback = std::function<std::size_t(neko::uchar *buffer, std::size_t size)>;
+
+    /**
+     * @brief Checks if the given file is an archive (ZIP, TAR, GZ, BZ2, XZ, RAR or 7Z).
+     * @param filePath The path to the file to check.
+     * @return True if the file is an archive, false for any other known type.
+     * @throws ex::FileError if the file cannot be opened or its type is unknown.
+     */
     inline bool isArchiveFile(const std::string &filePath) {
-        return util::detect::isTargetFileType(
-            filePath,
-            {"zip", "tar", "gz", "bz2", "xz", "rar", "7z"},
-            false);
+        using util::detect::FileType;
+        constexpr util::detect::FileTypeSet archiveTypes{
+            FileType::zip, FileType::tar, FileType::gz, FileType::bz2, FileType::xz, FileType::rar, FileType::sevenZip};
+        return archiveTypes.contains(util::detect::identifyKnownFileType(filePath));
     }
 
     namespace zip {
@@ -134,25 +338,160 @@ namespace neko::archive {
         /**
          * @brief Extracts the contents of a ZIP archive.
          * @param config Configuration for the extraction process.
+         * @return Totals of the extraction, with cancelled set if it was stopped.
          * @throws ex::FileError if the extraction fails.
          */
-        void extract(const ExtractConfig &config);
+        ArchiveSummary extract(const ExtractConfig &config);
         /**
          * @brief Creates a ZIP archive.
          * @param config Configuration for the creation process.
+         * @return Totals of the creation, with cancelled set if it was stopped.
          * @throws ex::FileError if the creation fails.
          */
-        void create(const CreateConfig &config);
+        ArchiveSummary create(const CreateConfig &config);
+
+        /**
+         * @brief Runs extract() on the shared thread pool.
+         * The config is copied, so the caller's config may go out of scope; the observer and stopToken are shared.
+         * @return A future holding the summary, or the exception thrown by extract().
+         */
+        std::future<ArchiveSummary> extractAsync(ExtractConfig config);
+        /**
+         * @brief Runs create() on the shared thread pool.
+         * The config is copied, so the caller's config may go out of scope; the observer and stopToken are shared.
+         * @return A future holding the summary, or the exception thrown by create().
+         */
+        std::future<ArchiveSummary> createAsync(CreateConfig config);
+
+        /**
+         * @brief Extracts the entries of an in-memory ZIP archive to a sink.
+         * Only password, includePaths and excludePaths of the config are used; directory entries are skipped.
+         * @param archive The complete archive content.
+         * @param config Filters and password for the extraction.
+         * @param sink Receives the content of each selected entry, in archive order.
+         * @throws ex::FileError if the archive cannot be read or an entry fails to decompress.
+         */
+        void extract(std::span<const neko::uchar> archive, const ExtractConfig &config, const EntrySink &sink);
+        /**
+         * @brief Extracts the entries of a ZIP archive read through a callback to a sink.
+         * The archive is buffered in memory first, since the central directory sits at its end.
+         * @param read Supplies the archive bytes.
+         * @param config Filters and password for the extraction.
+         * @param sink Receives the content of each selected entry, in archive order.
+         * @throws ex::FileError if the archive cannot be read or an entry fails to decompress.
+         */
+        void extract(const ReadCallback &read, const ExtractConfig &config, const EntrySink &sink);
+        /**
+         * @brief Extracts the entries of an in-memory ZIP archive into buffers.
+         * @param archive The complete archive content.
+         * @param config Filters and password for the extraction.
+         * @return The selected file entries, in archive order.
+         * @throws ex::FileError if the archive cannot be read or an entry fails to decompress.
+         */
+        std::vector<MemoryEntry> extractToMemory(std::span<const neko::uchar> archive, const ExtractConfig &config = {});
+        /**
+         * @brief Creates a ZIP archive in memory from named buffers.
+         * Only password, encryption, compressionLevel and storeCompressedInputs of the config are used.
+         * @param files The entries to write, in order.
+         * @param config Compression and encryption settings.
+         * @return The complete archive content.
+         * @throws ex::FileError if an entry cannot be written.
+         */
+        std::vector<neko::uchar> create(std::span<const MemoryFile> files, const CreateConfig &config = {});
+        /**
+         * @struct ZipEntryInfo
+         * @brief Central directory record of one archive entry.
+         */
+        struct ZipEntryInfo {
+            std::string name;                   // Entry name inside the archive
+            std::int64_t centralDirOffset = 0;  // Position of the record in the central directory
+            std::int64_t localHeaderOffset = 0; // Position of the local file header in the archive
+            std::int64_t compressedSize = 0;
+            std::int64_t uncompressedSize = 0;
+            std::uint32_t crc = 0;
+            std::uint16_t flag = 0;              // General purpose bit flag
+            std::uint16_t compressionMethod = 0; // e.g. 0 for store, 8 for deflate
+            std::time_t modified = 0;
+
+            bool isDirectory() const noexcept { return !name.empty() && name.back() == '/'; }
+            bool isEncrypted() const noexcept { return (flag & 0x1) != 0; }
+        };
+
+        /**
+         * @class ZipIndex
+         * @brief Opens an archive once and keeps its central directory as a lookup table.
+         *
+         * Entries are listed sorted by name and found by exact name in constant time, without walking the archive.
+         * All const member functions may be called concurrently; read() keeps a pool of reader handles,
+         * so each thread reuses an open handle instead of reopening the archive.
+         */
+        class ZipIndex {
+        public:
+            /**
+             * @brief Reads the central directory of an archive.
+             * @param archivePath Path to the ZIP archive.
+             * @param password Password used by read() for encrypted entries (optional).
+             * @throws ex::FileError if the archive cannot be opened.
+             */
+            explicit ZipIndex(std::string archivePath, std::string password = {});
+            ~ZipIndex();
+
+            ZipIndex(ZipIndex &&) noexcept;
+            ZipIndex &operator=(ZipIndex &&) noexcept;
+            ZipIndex(const ZipIndex &) = delete;
+            ZipIndex &operator=(const ZipIndex &) = delete;
+
+            /**
+             * @brief Looks up an entry by its exact name.
+             * @return The entry, or nullptr if the archive has no entry with that name.
+             */
+            const ZipEntryInfo *find(std::string_view name) const noexcept;
+
+            /**
+             * @brief All entries, sorted by name.
+             */
+            std::span<const ZipEntryInfo> entries() const noexcept { return entryTable; }
+            std::size_t size() const noexcept { return entryTable.size(); }
+            const std::string &path() const noexcept { return archivePath; }
+
+            /**
+             * @brief Decompresses one entry into a buffer.
+             * @param entry An entry of this index.
+             * @return The uncompressed content.
+             * @throws ex::FileError if the entry cannot be read or fails its CRC check.
+             */
+            std::vector<neko::uchar> read(const ZipEntryInfo &entry) const;
+            /**
+             * @brief Decompresses the entry with the given name into a buffer.
+             * @throws ex::FileError if there is no such entry, or it cannot be read.
+             */
+            std::vector<neko::uchar> read(std::string_view name) const;
+
+        private:
+            struct NameHash {
+                using is_transparent = void;
+                std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+            };
+            struct ReaderPool;
+
+            std::string archivePath;
+            std::string password;
+            std::vector<ZipEntryInfo> entryTable;
+            std::unordered_map<std::string, std::size_t, NameHash, std::equal_to<>> lookup;
+            std::unique_ptr<ReaderPool> readers;
+        };
+
         /**
          * @brief Checks if the given file is a ZIP archive.
          * @param filePath The path to the file to check.
-         * @return True if the file is a ZIP archive, false otherwise.
+         * @return True if the file is a ZIP archive, false for any other known type.
+         * @throws ex::FileError if the file cannot be opened or its type is unknown.
          */
         inline bool isZipArchiveFile(const std::string &filePath) {
-            return util::detect::isTargetFileType(
-                filePath,
-                {"zip", "jar", "apk", "xpi"},
-                false);
+            using util::detect::FileType;
+            // JAR and XPI files carry the ZIP signature and are detected as FileType::zip
+            constexpr util::detect::FileTypeSet zipTypes{FileType::zip, FileType::apk};
+            return zipTypes.contains(util::detect::identifyKnownFileType(filePath));
         }
 
     } // namespace zip
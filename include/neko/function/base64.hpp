@@ -0,0 +1,892 @@
+/**
+ * @file base64.hpp
+ * @brief Base64 encoding and decoding with vectorized kernels
+ * @author moehoshio
+ * @copyright Copyright (c) 2025 Hoshi
+ * @license MIT OR Apache-2.0
+ *
+ * The kernel is chosen once at runtime: AVX2 or SSSE3 on x86, NEON on AArch64, and a
+ * table-driven scalar loop everywhere else. All kernels produce identical output.
+ */
+
+#pragma once
+
+// Include header for non-module usage
+#if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
+
+#include <neko/schema/exception.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
+#endif // NEKO_FUNCTION_ENABLE_MODULE
+
+/**
+ * @namespace neko::util::base64
+ * @brief Base64 encoding and decoding utilities.
+ */
+namespace neko::util::base64 {
+
+    /**
+     * @brief Characters used for Base64 encoding.
+     */
+    constexpr std::string_view base64Chars =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "abcdefghijklmnopqrstuvwxyz"
+        "0123456789+/";
+
+    /**
+     * @brief Characters used for URL and filename safe Base64 (RFC 4648 section 5).
+     */
+    constexpr std::string_view base64UrlChars =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "abcdefghijklmnopqrstuvwxyz"
+        "0123456789-_";
+
+    /**
+     * @brief Base64 alphabet and padding.
+     * Decoding accepts padded and unpadded input for every variant.
+     */
+    enum class Variant {
+        standard,   ///< '+' and '/', padded with '='
+        url,        ///< '-' and '_', padded with '='
+        urlUnpadded ///< '-' and '_', without padding, as used by JWT
+    };
+
+    /**
+     * @namespace neko::util::base64::detail
+     * @brief Kernels and tables of the Base64 codec.
+     */
+    namespace detail {
+
+        inline constexpr std::uint8_t invalidChar = 0xFF;
+
+        /**
+         * @brief An encoding alphabet with its decode table.
+         * Every alphabet shares A-Z, a-z and 0-9 for values 0 to 61; only the characters for 62 and 63 differ.
+         */
+        struct Alphabet {
+            std::string_view chars;
+            std::array<std::uint8_t, 256> decode{};
+
+            constexpr char c62() const noexcept { return chars[62]; }
+            constexpr char c63() const noexcept { return chars[63]; }
+        };
+
+        constexpr Alphabet makeAlphabet(std::string_view chars) {
+            Alphabet alphabet{chars, {}};
+            alphabet.decode.fill(invalidChar);
+            for (std::size_t i = 0; i < 64; ++i) {
+                alphabet.decode[static_cast<unsigned char>(chars[i])] = static_cast<std::uint8_t>(i);
+            }
+            return alphabet;
+        }
+
+        inline constexpr Alphabet standardAlphabet = makeAlphabet(base64Chars);
+        inline constexpr Alphabet urlAlphabet = makeAlphabet(base64UrlChars);
+
+        constexpr const Alphabet &alphabetOf(Variant variant) noexcept {
+            return variant == Variant::standard ? standardAlphabet : urlAlphabet;
+        }
+
+        constexpr bool isPadded(Variant variant) noexcept {
+            return variant != Variant::urlUnpadded;
+        }
+
+        enum class Kernel {
+            scalar,
+            ssse3,
+            avx2,
+            neon
+        };
+
+        // ===================
+        // ===== Scalar ======
+        // ===================
+
+        /**
+         * @brief Encodes whole 3-byte groups; returns the number of input bytes consumed.
+         */
+        inline std::size_t encodeScalar(const unsigned char *in, std::size_t size, char *out, const Alphabet &alphabet) noexcept {
+            std::size_t i = 0;
+            for (; i + 3 <= size; i += 3, out += 4) {
+                const std::uint32_t v = (std::uint32_t(in[i]) << 16) | (std::uint32_t(in[i + 1]) << 8) | in[i + 2];
+                out[0] = alphabet.chars[(v >> 18) & 0x3F];
+                out[1] = alphabet.chars[(v >> 12) & 0x3F];
+                out[2] = alphabet.chars[(v >> 6) & 0x3F];
+                out[3] = alphabet.chars[v & 0x3F];
+            }
+            return i;
+        }
+
+        /**
+         * @brief Decodes whole 4-character groups, stopping before the first group with a character outside the alphabet.
+         * @return The number of characters consumed, a multiple of 4.
+         */
+        inline std::size_t decodeScalar(const char *in, std::size_t size, unsigned char *out, const Alphabet &alphabet) noexcept {
+            std::size_t i = 0;
+            for (; i + 4 <= size; i += 4, out += 3) {
+                const std::uint32_t a = alphabet.decode[static_cast<unsigned char>(in[i])];
+                const std::uint32_t b = alphabet.decode[static_cast<unsigned char>(in[i + 1])];
+                const std::uint32_t c = alphabet.decode[static_cast<unsigned char>(in[i + 2])];
+                const std::uint32_t d = alphabet.decode[static_cast<unsigned char>(in[i + 3])];
+                if ((a | b | c | d) & 0xC0)
+                    break;
+                const std::uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+                out[0] = static_cast<unsigned char>(v >> 16);
+                out[1] = static_cast<unsigned char>(v >> 8);
+                out[2] = static_cast<unsigned char>(v);
+            }
+            return i;
+        }
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        // ===================
+        // ======= x86 =======
+        // ===================
+
+        /**
+         * @brief Picks the widest kernel the CPU and OS support, once.
+         */
+        inline Kernel detectKernel() noexcept {
+            static const Kernel kernel = [] {
+#if defined(_MSC_VER)
+                int info[4] = {0};
+                __cpuid(info, 0);
+                const int maxLeaf = info[0];
+                __cpuid(info, 1);
+                const bool ssse3 = (info[2] & (1 << 9)) != 0;
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const bool avx = (info[2] & (1 << 28)) != 0;
+                bool avx2 = false;
+                if (osxsave && avx && maxLeaf >= 7 && (_xgetbv(0) & 6) == 6) {
+                    __cpuidex(info, 7, 0);
+                    avx2 = (info[1] & (1 << 5)) != 0;
+                }
+                return avx2 ? Kernel::avx2 : ssse3 ? Kernel::ssse3 : Kernel::scalar;
+#else
+                return __builtin_cpu_supports("avx2") ? Kernel::avx2 : __builtin_cpu_supports("ssse3") ? Kernel::ssse3 : Kernel::scalar;
+#endif
+            }();
+            return kernel;
+        }
+
+        // Maps 6-bit values to characters: one shuffle selects the offset for each range (Muła's pshufb lookup)
+#if !defined(_MSC_VER)
+        __attribute__((target("ssse3")))
+#endif
+        inline __m128i
+        encodeOffsetsSsse3(const Alphabet &alphabet) noexcept {
+            return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                 static_cast<char>(alphabet.c62() - 62), static_cast<char>(alphabet.c63() - 63), 'A', 0, 0);
+        }
+
+        /**
+         * @brief Encodes 12 bytes per step from 16-byte loads; returns the number of input bytes consumed.
+         */
+#if !defined(_MSC_VER)
+        __attribute__((target("ssse3")))
+#endif
+        inline std::size_t
+        encodeSsse3(const unsigned char *in, std::size_t size, char *out, const Alphabet &alphabet) noexcept {
+            const __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+            const __m128i offsets = encodeOffsetsSsse3(alphabet);
+            std::size_t i = 0;
+            for (; i + 16 <= size; i += 12, out += 16) {
+                __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), shuffle);
+                // Spread the 24 bits of each group over four bytes, 6 bits each
+                const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+                const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+                const __m128i indices = _mm_or_si128(t0, t1);
+                __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+                range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+                const __m128i chars = _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), chars);
+            }
+            return i;
+        }
+
+        /**
+         * @brief Decodes 16 characters per step while 16 output bytes are writable.
+         * @return The number of characters consumed; stops before a block with a character outside the alphabet.
+         */
+#if !defined(_MSC_VER)
+        __attribute__((target("ssse3")))
+#endif
+        inline std::size_t
+        decodeSsse3(const char *in, std::size_t size, unsigned char *out, std::size_t capacity, const Alphabet &alphabet) noexcept {
+            const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+            std::size_t i = 0;
+            for (std::size_t written = 0; i + 16 <= size && written + 16 <= capacity; i += 16, written += 12, out += 12) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                // Bytes above 0x7F compare as negative and fall outside every range
+                const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), v));
+                const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), v));
+                const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), v));
+                const __m128i is62 = _mm_cmpeq_epi8(v, _mm_set1_epi8(alphabet.c62()));
+                const __m128i is63 = _mm_cmpeq_epi8(v, _mm_set1_epi8(alphabet.c63()));
+                const __m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, is62)), is63);
+                if (_mm_movemask_epi8(valid) != 0xFFFF)
+                    break;
+                const __m128i shift = _mm_or_si128(
+                    _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+                    _mm_or_si128(_mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+                                 _mm_or_si128(_mm_and_si128(is62, _mm_set1_epi8(static_cast<char>(62 - alphabet.c62()))),
+                                              _mm_and_si128(is63, _mm_set1_epi8(static_cast<char>(63 - alphabet.c63()))))));
+                const __m128i values = _mm_add_epi8(v, shift);
+                // Join pairs of 6-bit values into 12 bits, then pairs of those into 24 bits, and drop the empty bytes
+                const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+                const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(words, pack));
+            }
+            return i;
+        }
+
+        /**
+         * @brief Encodes 24 bytes per step; returns the number of input bytes consumed.
+         */
+#if !defined(_MSC_VER)
+        __attribute__((target("avx2")))
+#endif
+        inline std::size_t
+        encodeAvx2(const unsigned char *in, std::size_t size, char *out, const Alphabet &alphabet) noexcept {
+            const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                     1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+            const __m256i offsets = _mm256_broadcastsi128_si256(encodeOffsetsSsse3(alphabet));
+            std::size_t i = 0;
+            for (; i + 28 <= size; i += 24, out += 32) {
+                const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 12));
+                __m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), shuffle);
+                const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+                const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+                const __m256i indices = _mm256_or_si256(t0, t1);
+                __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+                range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+                const __m256i chars = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, range), indices);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), chars);
+            }
+            return i;
+        }
+
+        /**
+         * @brief Decodes 32 characters per step while 32 output bytes are writable.
+         * @return The number of characters consumed; stops before a block with a character outside the alphabet.
+         */
+#if !defined(_MSC_VER)
+        __attribute__((target("avx2")))
+#endif
+        inline std::size_t
+        decodeAvx2(const char *in, std::size_t size, unsigned char *out, std::size_t capacity, const Alphabet &alphabet) noexcept {
+            const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                  2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+            const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+            std::size_t i = 0;
+            for (std::size_t written = 0; i + 32 <= size && written + 32 <= capacity; i += 32, written += 24, out += 24) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+                const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+                const __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), v));
+                const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+                const __m256i is62 = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(alphabet.c62()));
+                const __m256i is63 = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(alphabet.c63()));
+                const __m256i valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, is62)), is63);
+                if (_mm256_movemask_epi8(valid) != -1)
+                    break;
+                const __m256i shift = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))),
+                    _mm256_or_si256(_mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')),
+                                    _mm256_or_si256(_mm256_and_si256(is62, _mm256_set1_epi8(static_cast<char>(62 - alphabet.c62()))),
+                                                    _mm256_and_si256(is63, _mm256_set1_epi8(static_cast<char>(63 - alphabet.c63()))))));
+                const __m256i values = _mm256_add_epi8(v, shift);
+                const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+                const __m256i words = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+                // 12 bytes per lane, moved next to each other
+                const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(words, pack), lanes);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), packed);
+            }
+            return i;
+        }
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        // ===================
+        // ====== NEON =======
+        // ===================
+
+        // NEON is part of the AArch64 baseline
+        inline Kernel detectKernel() noexcept {
+            return Kernel::neon;
+        }
+
+        /**
+         * @brief Encodes 48 bytes per step with de-interleaving loads; returns the number of input bytes consumed.
+         */
+        inline std::size_t encodeNeon(const unsigned char *in, std::size_t size, char *out, const Alphabet &alphabet) noexcept {
+            const auto *chars = reinterpret_cast<const std::uint8_t *>(alphabet.chars.data());
+            uint8x16x4_t table;
+            table.val[0] = vld1q_u8(chars);
+            table.val[1] = vld1q_u8(chars + 16);
+            table.val[2] = vld1q_u8(chars + 32);
+            table.val[3] = vld1q_u8(chars + 48);
+            const uint8x16_t mask = vdupq_n_u8(0x3F);
+            std::size_t i = 0;
+            for (; i + 48 <= size; i += 48, out += 64) {
+                const uint8x16x3_t s = vld3q_u8(in + i);
+                uint8x16x4_t r;
+                r.val[0] = vshrq_n_u8(s.val[0], 2);
+                r.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(s.val[0], 4), vshrq_n_u8(s.val[1], 4)), mask);
+                r.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(s.val[1], 2), vshrq_n_u8(s.val[2], 6)), mask);
+                r.val[3] = vandq_u8(s.val[2], mask);
+                r.val[0] = vqtbl4q_u8(table, r.val[0]);
+                r.val[1] = vqtbl4q_u8(table, r.val[1]);
+                r.val[2] = vqtbl4q_u8(table, r.val[2]);
+                r.val[3] = vqtbl4q_u8(table, r.val[3]);
+                vst4q_u8(reinterpret_cast<std::uint8_t *>(out), r);
+            }
+            return i;
+        }
+
+        /**
+         * @brief Decodes 64 characters per step.
+         * @return The number of characters consumed; stops before a block with a character outside the alphabet.
+         */
+        inline std::size_t decodeNeon(const char *in, std::size_t size, unsigned char *out, std::size_t, const Alphabet &alphabet) noexcept {
+            const std::uint8_t *decode = alphabet.decode.data();
+            uint8x16x4_t low, high;
+            for (int k = 0; k < 4; ++k) {
+                low.val[k] = vld1q_u8(decode + 16 * k);
+                high.val[k] = vld1q_u8(decode + 64 + 16 * k);
+            }
+            const uint8x16_t offset = vdupq_n_u8(64);
+            std::size_t i = 0;
+            for (; i + 64 <= size; i += 64, out += 48) {
+                const uint8x16x4_t c = vld4q_u8(reinterpret_cast<const std::uint8_t *>(in + i));
+                uint8x16_t v[4];
+                uint8x16_t bad = vdupq_n_u8(0);
+                for (int k = 0; k < 4; ++k) {
+                    // Characters 0-63 hit the first table, 64-127 the second; out-of-range indices yield 0
+                    v[k] = vorrq_u8(vqtbl4q_u8(low, c.val[k]), vqtbl4q_u8(high, vsubq_u8(c.val[k], offset)));
+                    bad = vorrq_u8(bad, vorrq_u8(vcgtq_u8(v[k], vdupq_n_u8(63)), vcgtq_u8(c.val[k], vdupq_n_u8(127))));
+                }
+                if (vmaxvq_u8(bad) != 0)
+                    break;
+                uint8x16x3_t r;
+                r.val[0] = vorrq_u8(vshlq_n_u8(v[0], 2), vshrq_n_u8(v[1], 4));
+                r.val[1] = vorrq_u8(vshlq_n_u8(v[1], 4), vshrq_n_u8(v[2], 2));
+                r.val[2] = vorrq_u8(vshlq_n_u8(v[2], 6), v[3]);
+                vst3q_u8(out, r);
+            }
+            return i;
+        }
+
+#else
+        inline Kernel detectKernel() noexcept {
+            return Kernel::scalar;
+        }
+#endif
+
+        /**
+         * @brief Encodes whole 3-byte groups with the given kernel; returns the number of input bytes consumed.
+         */
+        inline std::size_t encodeBlocks(Kernel kernel, const unsigned char *in, std::size_t size, char *out, const Alphabet &alphabet) noexcept {
+            std::size_t done = 0;
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            if (kernel == Kernel::avx2)
+                done = encodeAvx2(in, size, out, alphabet);
+            if (kernel == Kernel::avx2 || kernel == Kernel::ssse3)
+                done += encodeSsse3(in + done, size - done, out + done / 3 * 4, alphabet);
+#elif defined(__aarch64__) || defined(_M_ARM64)
+            if (kernel == Kernel::neon)
+                done = encodeNeon(in, size, out, alphabet);
+#endif
+            return done + encodeScalar(in + done, size - done, out + done / 3 * 4, alphabet);
+        }
+
+        /**
+         * @brief Decodes whole 4-character groups with the given kernel.
+         * @param capacity Writable bytes at out; the vector kernels store whole registers.
+         * @return The number of characters consumed, stopping before the first group with a character outside the alphabet.
+         */
+        inline std::size_t decodeBlocks(Kernel kernel, const char *in, std::size_t size, unsigned char *out, std::size_t capacity, const Alphabet &alphabet) noexcept {
+            std::size_t done = 0;
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            if (kernel == Kernel::avx2)
+                done = decodeAvx2(in, size, out, capacity, alphabet);
+            if (kernel == Kernel::avx2 || kernel == Kernel::ssse3)
+                done += decodeSsse3(in + done, size - done, out + done / 4 * 3, capacity - done / 4 * 3, alphabet);
+#elif defined(__aarch64__) || defined(_M_ARM64)
+            if (kernel == Kernel::neon)
+                done = decodeNeon(in, size, out, capacity, alphabet);
+#endif
+            (void)capacity;
+            return done + decodeScalar(in + done, size - done, out + done / 4 * 3, alphabet);
+        }
+
+        /**
+         * @brief Encodes a buffer, including the final partial group.
+         * @return The number of characters written.
+         */
+        inline std::size_t encodeTo(Kernel kernel, const unsigned char *in, std::size_t size, char *out, const Alphabet &alphabet, bool pad) noexcept {
+            const std::size_t done = encodeBlocks(kernel, in, size, out, alphabet);
+            char *tail = out + done / 3 * 4;
+            const std::size_t rest = size - done;
+            if (rest == 0)
+                return static_cast<std::size_t>(tail - out);
+            const std::uint32_t v = (std::uint32_t(in[done]) << 16) | (rest == 2 ? std::uint32_t(in[done + 1]) << 8 : 0);
+            *tail++ = alphabet.chars[(v >> 18) & 0x3F];
+            *tail++ = alphabet.chars[(v >> 12) & 0x3F];
+            if (rest == 2)
+                *tail++ = alphabet.chars[(v >> 6) & 0x3F];
+            else if (pad)
+                *tail++ = '=';
+            if (pad)
+                *tail++ = '=';
+            return static_cast<std::size_t>(tail - out);
+        }
+
+        /**
+         * @brief Decodes the final 2 or 3 characters of an unpadded group.
+         * @return The number of bytes written, or 0 if a character is outside the alphabet.
+         */
+        inline std::size_t decodeTail(const char *in, std::size_t size, unsigned char *out, const Alphabet &alphabet) noexcept {
+            std::uint32_t v = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                const std::uint8_t d = alphabet.decode[static_cast<unsigned char>(in[i])];
+                if (d == invalidChar)
+                    return 0;
+                v = (v << 6) | d;
+            }
+            if (size == 2) {
+                out[0] = static_cast<unsigned char>(v >> 4);
+                return 1;
+            }
+            if (size == 3) {
+                out[0] = static_cast<unsigned char>(v >> 10);
+                out[1] = static_cast<unsigned char>(v >> 2);
+                return 2;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Length of the input without its padding, or npos if the padding is malformed.
+         */
+        constexpr std::size_t unpaddedLength(std::string_view input) noexcept {
+            std::size_t size = input.size();
+            if (size % 4 == 0 && size >= 4) {
+                if (input[size - 1] == '=')
+                    --size;
+                if (input[size - 1] == '=')
+                    --size;
+            }
+            return size % 4 == 1 ? std::string_view::npos : size;
+        }
+
+        /**
+         * @brief Strictly decodes a padded or unpadded input.
+         * @return The number of bytes written, or std::nullopt if the input is not valid Base64.
+         */
+        inline std::optional<std::size_t> decodeTo(Kernel kernel, std::string_view input, unsigned char *out, std::size_t capacity, const Alphabet &alphabet) noexcept {
+            const std::size_t size = unpaddedLength(input);
+            if (size == std::string_view::npos)
+                return std::nullopt;
+            const std::size_t whole = size - size % 4;
+            const std::size_t done = decodeBlocks(kernel, input.data(), whole, out, capacity, alphabet);
+            if (done != whole)
+                return std::nullopt;
+            const std::size_t rest = size - whole;
+            const std::size_t tail = decodeTail(input.data() + whole, rest, out + whole / 4 * 3, alphabet);
+            if (rest != 0 && tail == 0)
+                return std::nullopt;
+            return whole / 4 * 3 + tail;
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Number of characters produced by encoding size bytes.
+     */
+    constexpr std::size_t encodedSize(std::size_t size, Variant variant = Variant::standard) noexcept {
+        if (detail::isPadded(variant))
+            return (size + 2) / 3 * 4;
+        return size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+    }
+
+    /**
+     * @brief Exact number of bytes the encoded input decodes to, assuming it is valid.
+     * Accepts padded and unpadded input.
+     */
+    constexpr std::size_t decodedSize(std::string_view encoded) noexcept {
+        const std::size_t size = detail::unpaddedLength(encoded);
+        if (size == std::string_view::npos)
+            return 0;
+        return size / 4 * 3 + (size % 4 == 0 ? 0 : size % 4 - 1);
+    }
+
+    /**
+     * @brief Encodes into a caller-provided buffer.
+     * @param input Bytes to encode
+     * @param output Destination, at least encodedSize(input.size(), variant) characters
+     * @param variant Alphabet and padding to use
+     * @return The number of characters written
+     * @throws ex::InvalidArgument if the output buffer is too small
+     */
+    inline std::size_t encode(std::span<const std::byte> input, std::span<char> output, Variant variant = Variant::standard) {
+        if (output.size() < encodedSize(input.size(), variant))
+            throw ex::InvalidArgument("Base64 output buffer too small");
+        return detail::encodeTo(detail::detectKernel(), reinterpret_cast<const unsigned char *>(input.data()), input.size(), output.data(),
+                                detail::alphabetOf(variant), detail::isPadded(variant));
+    }
+
+    /**
+     * @brief Encodes bytes into a new string, sized exactly once.
+     */
+    inline std::string encode(std::span<const std::byte> input, Variant variant = Variant::standard) {
+        std::string output(encodedSize(input.size(), variant), '\0');
+        detail::encodeTo(detail::detectKernel(), reinterpret_cast<const unsigned char *>(input.data()), input.size(), output.data(),
+                         detail::alphabetOf(variant), detail::isPadded(variant));
+        return output;
+    }
+
+    inline std::string encode(std::string_view input, Variant variant = Variant::standard) {
+        return encode(std::as_bytes(std::span(input.data(), input.size())), variant);
+    }
+
+    /**
+     * @brief Decodes into a caller-provided buffer.
+     * Padded and unpadded input are accepted; any other character outside the alphabet is an error.
+     * @param input Base64 text
+     * @param output Destination, at least decodedSize(input) bytes
+     * @param variant Alphabet of the input
+     * @return The number of bytes written, or std::nullopt if the input is not valid Base64
+     * @throws ex::InvalidArgument if the output buffer is too small
+     */
+    inline std::optional<std::size_t> decode(std::string_view input, std::span<std::byte> output, Variant variant = Variant::standard) {
+        if (output.size() < decodedSize(input))
+            throw ex::InvalidArgument("Base64 output buffer too small");
+        return detail::decodeTo(detail::detectKernel(), input, reinterpret_cast<unsigned char *>(output.data()), output.size(),
+                                detail::alphabetOf(variant));
+    }
+
+    /**
+     * @brief Decodes into a new string, sized exactly once.
+     * @return The decoded bytes, or std::nullopt if the input is not valid Base64
+     */
+    inline std::optional<std::string> decode(std::string_view input, Variant variant = Variant::standard) {
+        std::string output(decodedSize(input), '\0');
+        auto written = detail::decodeTo(detail::detectKernel(), input, reinterpret_cast<unsigned char *>(output.data()), output.size(),
+                                        detail::alphabetOf(variant));
+        if (!written)
+            return std::nullopt;
+        output.resize(*written);
+        return output;
+    }
+
+    /**
+     * @brief Upper bound on the bytes Decoder::update() produces for size characters, counting up to three carried over.
+     */
+    constexpr std::size_t decodedSizeBound(std::size_t size) noexcept {
+        return (size + 3) * 3 / 4;
+    }
+
+    /**
+     * @brief Incremental Base64 encoder.
+     *
+     * Feed chunks of any size with update() and call finish() once to write the final group.
+     * Up to two bytes are carried between calls, so the output matches encoding the whole input at once.
+     */
+    class Encoder {
+    public:
+        explicit Encoder(Variant variant = Variant::standard) noexcept
+            : variant(variant) {}
+
+        /**
+         * @brief Encodes the next chunk.
+         * @param output Destination, at least encodedSize(input.size()) characters
+         * @return The number of characters written
+         * @throws ex::InvalidArgument if the output buffer is too small
+         */
+        std::size_t update(std::span<const std::byte> input, std::span<char> output) {
+            if (output.size() < encodedSize(input.size()))
+                throw ex::InvalidArgument("Base64 output buffer too small");
+            const auto *in = reinterpret_cast<const unsigned char *>(input.data());
+            std::size_t size = input.size();
+            char *out = output.data();
+            const detail::Alphabet &alphabet = detail::alphabetOf(variant);
+
+            if (pendingSize > 0) {
+                while (pendingSize < 3 && size > 0) {
+                    pending[pendingSize++] = *in++;
+                    --size;
+                }
+                if (pendingSize < 3)
+                    return 0;
+                out += detail::encodeScalar(pending.data(), 3, out, alphabet) / 3 * 4;
+                pendingSize = 0;
+            }
+            const std::size_t done = detail::encodeBlocks(detail::detectKernel(), in, size, out, alphabet);
+            out += done / 3 * 4;
+            for (std::size_t i = done; i < size; ++i)
+                pending[pendingSize++] = in[i];
+            return static_cast<std::size_t>(out - output.data());
+        }
+
+        std::string update(std::span<const std::byte> input) {
+            std::string output(encodedSize(input.size()), '\0');
+            output.resize(update(input, output));
+            return output;
+        }
+
+        std::string update(std::string_view input) {
+            return update(std::as_bytes(std::span(input.data(), input.size())));
+        }
+
+        /**
+         * @brief Writes the final partial group and padding, then resets the encoder for reuse.
+         * @param output Destination, at least 4 characters
+         * @return The number of characters written
+         * @throws ex::InvalidArgument if the output buffer is too small
+         */
+        std::size_t finish(std::span<char> output) {
+            if (output.size() < 4)
+                throw ex::InvalidArgument("Base64 output buffer too small");
+            const std::size_t written = detail::encodeTo(detail::Kernel::scalar, pending.data(), pendingSize, output.data(),
+                                                         detail::alphabetOf(variant), detail::isPadded(variant));
+            pendingSize = 0;
+            return written;
+        }
+
+        std::string finish() {
+            std::string output(4, '\0');
+            output.resize(finish(output));
+            return output;
+        }
+
+    private:
+        Variant variant;
+        std::array<unsigned char, 3> pending{};
+        std::size_t pendingSize = 0;
+    };
+
+    /**
+     * @brief Incremental strict Base64 decoder.
+     *
+     * Feed text chunks with update() and call finish() once at the end. Groups and padding may be
+     * split across chunks. Once a call reports invalid input, the decoder stays failed until finish().
+     */
+    class Decoder {
+    public:
+        explicit Decoder(Variant variant = Variant::standard) noexcept
+            : variant(variant) {}
+
+        /**
+         * @brief Decodes the next chunk.
+         * @param output Destination, at least decodedSizeBound(input.size()) bytes
+         * @return The number of bytes written, or std::nullopt if the input is not valid Base64
+         * @throws ex::InvalidArgument if the output buffer is too small
+         */
+        std::optional<std::size_t> update(std::string_view input, std::span<std::byte> output) {
+            if (output.size() < decodedSizeBound(input.size()))
+                throw ex::InvalidArgument("Base64 output buffer too small");
+            if (failed)
+                return std::nullopt;
+            auto *out = reinterpret_cast<unsigned char *>(output.data());
+            std::size_t written = 0;
+            std::size_t i = 0;
+            const detail::Alphabet &alphabet = detail::alphabetOf(variant);
+
+            // Complete the group carried over from the previous chunk
+            while (pendingSize > 0 && i < input.size() && padding == 0) {
+                if (!push(input[i++], out, written))
+                    return fail();
+            }
+            if (pendingSize == 0 && padding == 0) {
+                const std::size_t whole = (input.size() - i) / 4 * 4;
+                const std::size_t done = detail::decodeBlocks(detail::detectKernel(), input.data() + i, whole, out + written,
+                                                              output.size() - written, alphabet);
+                written += done / 4 * 3;
+                i += done;
+            }
+            for (; i < input.size(); ++i) {
+                if (!push(input[i], out, written))
+                    return fail();
+            }
+            return written;
+        }
+
+        std::optional<std::string> update(std::string_view input) {
+            std::string output(decodedSizeBound(input.size()), '\0');
+            auto written = update(input, std::as_writable_bytes(std::span(output.data(), output.size())));
+            if (!written)
+                return std::nullopt;
+            output.resize(*written);
+            return output;
+        }
+
+        /**
+         * @brief Decodes a trailing unpadded group, checks the padding, then resets the decoder for reuse.
+         * @param output Destination, at least 2 bytes
+         * @return The number of bytes written, or std::nullopt if the input was not valid Base64
+         * @throws ex::InvalidArgument if the output buffer is too small
+         */
+        std::optional<std::size_t> finish(std::span<std::byte> output) {
+            if (output.size() < 2)
+                throw ex::InvalidArgument("Base64 output buffer too small");
+            const bool valid = !failed && pendingSize != 1 && (padding == 0 || padding == expectedPadding);
+            std::size_t written = 0;
+            if (valid && padding == 0)
+                written = detail::decodeTail(pending.data(), pendingSize, reinterpret_cast<unsigned char *>(output.data()), detail::alphabetOf(variant));
+            failed = false;
+            pendingSize = padding = expectedPadding = 0;
+            if (!valid)
+                return std::nullopt;
+            return written;
+        }
+
+        std::optional<std::string> finish() {
+            std::string output(2, '\0');
+            auto written = finish(std::as_writable_bytes(std::span(output.data(), output.size())));
+            if (!written)
+                return std::nullopt;
+            output.resize(*written);
+            return output;
+        }
+
+    private:
+        // Takes one character; a full group or the first '=' flushes the pending characters
+        bool push(char c, unsigned char *out, std::size_t &written) noexcept {
+            const detail::Alphabet &alphabet = detail::alphabetOf(variant);
+            if (c == '=') {
+                if (padding == 0) {
+                    if (pendingSize < 2)
+                        return false;
+                    expectedPadding = 4 - pendingSize;
+                    written += detail::decodeTail(pending.data(), pendingSize, out + written, alphabet);
+                    pendingSize = 0;
+                }
+                return ++padding <= expectedPadding;
+            }
+            if (padding != 0 || alphabet.decode[static_cast<unsigned char>(c)] == detail::invalidChar)
+                return false;
+            pending[pendingSize++] = c;
+            if (pendingSize == 4) {
+                written += detail::decodeScalar(pending.data(), 4, out + written, alphabet) / 4 * 3;
+                pendingSize = 0;
+            }
+            return true;
+        }
+
+        std::nullopt_t fail() noexcept {
+            failed = true;
+            return std::nullopt;
+        }
+
+        Variant variant;
+        std::array<char, 4> pending{};
+        std::size_t pendingSize = 0;
+        std::size_t padding = 0;
+        std::size_t expectedPadding = 0;
+        bool failed = false;
+    };
+
+    /**
+     * @brief Encodes a stream into another, chunk by chunk.
+     * @return The number of characters written
+     */
+    inline std::size_t encode(std::istream &input, std::ostream &output, Variant variant = Variant::standard) {
+        constexpr std::size_t chunkSize = 48 * 1024;
+        std::string in(chunkSize, '\0');
+        std::string out(encodedSize(chunkSize), '\0');
+        Encoder encoder(variant);
+        std::size_t total = 0;
+        while (input) {
+            input.read(in.data(), static_cast<std::streamsize>(in.size()));
+            const auto got = static_cast<std::size_t>(input.gcount());
+            if (got == 0)
+                break;
+            const std::size_t n = encoder.update(std::as_bytes(std::span(in.data(), got)), out);
+            output.write(out.data(), static_cast<std::streamsize>(n));
+            total += n;
+        }
+        const std::size_t n = encoder.finish(out);
+        output.write(out.data(), static_cast<std::streamsize>(n));
+        return total + n;
+    }
+
+    /**
+     * @brief Strictly decodes a stream into another, chunk by chunk.
+     * Output produced before invalid input is detected has already been written.
+     * @return The number of bytes written, or std::nullopt if the input is not valid Base64
+     */
+    inline std::optional<std::size_t> decode(std::istream &input, std::ostream &output, Variant variant = Variant::standard) {
+        constexpr std::size_t chunkSize = 64 * 1024;
+        std::string in(chunkSize, '\0');
+        std::string out(decodedSizeBound(chunkSize), '\0');
+        auto outBytes = std::as_writable_bytes(std::span(out.data(), out.size()));
+        Decoder decoder(variant);
+        std::size_t total = 0;
+        while (input) {
+            input.read(in.data(), static_cast<std::streamsize>(in.size()));
+            const auto got = static_cast<std::size_t>(input.gcount());
+            if (got == 0)
+                break;
+            auto n = decoder.update(std::string_view(in.data(), got), outBytes);
+            if (!n) {
+                decoder.finish(outBytes);
+                return std::nullopt;
+            }
+            output.write(out.data(), static_cast<std::streamsize>(*n));
+            total += *n;
+        }
+        auto n = decoder.finish(outBytes);
+        if (!n)
+            return std::nullopt;
+        output.write(out.data(), static_cast<std::streamsize>(*n));
+        return total + *n;
+    }
+
+    /**
+     * @brief Encodes a string using Base64.
+     * @param input String to encode
+     * @return Base64 encoded string
+     */
+    inline std::string base64Encode(const std::string &input) {
+        return encode(std::string_view(input));
+    }
+
+    /**
+     * @brief Decodes a Base64 encoded string.
+     * Decoding stops at the first character outside the alphabet, such as the padding.
+     * @param input Base64 encoded string
+     * @return Decoded string
+     */
+    inline std::string base64Decode(const std::string &input) {
+        const detail::Alphabet &alphabet = detail::standardAlphabet;
+        std::string output(input.size() / 4 * 3 + 3, '\0');
+        auto *out = reinterpret_cast<unsigned char *>(output.data());
+        const std::size_t done = detail::decodeBlocks(detail::detectKernel(), input.data(), input.size(), out, output.size(), alphabet);
+        // The valid prefix ends within the next group
+        std::size_t end = done;
+        while (end < input.size() && end < done + 4 && alphabet.decode[static_cast<unsigned char>(input[end])] != detail::invalidChar)
+            ++end;
+        const std::size_t written = done / 4 * 3 + detail::decodeTail(input.data() + done, end - done, out + done / 4 * 3, alphabet);
+        output.resize(written);
+        return output;
+    }
+
+} // namespace neko::util::base64
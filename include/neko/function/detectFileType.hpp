@@ -3,20 +3,37 @@
 // Include header for non-module usage
 #if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
 
+#include <neko/function/mappedFile.hpp>
+#include <neko/function/profile.hpp>
+#include <neko/function/threadPool.hpp>
 #include <neko/function/utilities.hpp>
 #include <neko/schema/exception.hpp>
 #include <neko/schema/types.hpp>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
+#include <initializer_list>
 #include <iomanip>
 #include <iostream>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #endif
 
 /**
@@ -25,6 +42,107 @@
  */
 namespace neko::util::detect {
 
+    /**
+     * @brief Identifies a detectable file type without allocating.
+     * The string results of detectFileType are the names returned by fileTypeName.
+     */
+    enum class FileType : std::uint8_t {
+        unknown,
+        // text files
+        txt, csv, json, xml, html,
+        // image files
+        bmp, gif, jpeg, png,
+        // audio files
+        mp3, wav, avi, flac, ogg,
+        // video files
+        mp4, mov, mkv,
+        // archive files
+        zip, docx, xlsx, pptx, apk, rar, sevenZip, tar, gz, bz2, lzma, xz, zst, lzo, lz4,
+        // executable files
+        exe, pe, dll, sys, com, elf, msi, macho,
+        // document files
+        pdf, iso, psd, swf,
+        count // Number of types, not a type
+    };
+
+    namespace detail {
+        inline constexpr std::string_view fileTypeNames[] = {
+            "Unknown",
+            "TXT", "CSV", "JSON", "XML", "HTML",
+            "BMP", "GIF", "JPEG", "PNG",
+            "MP3", "WAV", "AVI", "FLAC", "OGG",
+            "MP4", "MOV", "MKV",
+            "ZIP", "DOCX", "XLSX", "PPTX", "APK", "RAR", "7Z", "TAR", "GZ", "BZ2", "LZMA", "XZ", "ZST", "LZO", "LZ4",
+            "EXE", "PE", "DLL", "SYS", "COM", "ELF", "MSI", "MACHO",
+            "PDF", "ISO", "PSD", "SWF"};
+        static_assert(std::size(fileTypeNames) == static_cast<std::size_t>(FileType::count), "fileTypeNames must list every FileType");
+    } // namespace detail
+
+    /**
+     * @brief The name of a file type, e.g. "PNG" or "7Z"; "Unknown" for FileType::unknown.
+     */
+    constexpr std::string_view fileTypeName(FileType type) noexcept {
+        auto index = static_cast<std::size_t>(type);
+        return index < std::size(detail::fileTypeNames) ? detail::fileTypeNames[index] : detail::fileTypeNames[0];
+    }
+
+    /**
+     * @brief Find the file type with the given name, ignoring ASCII case.
+     * @return The type, or FileType::unknown if no type has that name.
+     */
+    constexpr FileType fileTypeFromName(std::string_view name) noexcept {
+        auto upper = [](char c) { return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c; };
+        for (std::size_t i = 1; i < std::size(detail::fileTypeNames); ++i) {
+            const auto candidate = detail::fileTypeNames[i];
+            if (candidate.size() == name.size() &&
+                std::equal(candidate.begin(), candidate.end(), name.begin(), [&](char a, char b) { return a == upper(b); }))
+                return static_cast<FileType>(i);
+        }
+        return FileType::unknown;
+    }
+
+    /**
+     * @class FileTypeSet
+     * @brief A set of file types stored as a bitmask, so a membership test is a single AND.
+     * FileType::unknown is never a member.
+     */
+    class FileTypeSet {
+        static_assert(static_cast<std::size_t>(FileType::count) <= 64, "FileTypeSet holds at most 64 types");
+        std::uint64_t bits = 0;
+
+        static constexpr std::uint64_t bit(FileType type) noexcept {
+            return type == FileType::unknown || type >= FileType::count ? 0 : std::uint64_t(1) << static_cast<unsigned>(type);
+        }
+
+    public:
+        constexpr FileTypeSet() noexcept = default;
+        constexpr FileTypeSet(std::initializer_list<FileType> types) noexcept {
+            for (auto type : types)
+                bits |= bit(type);
+        }
+
+        constexpr FileTypeSet &insert(FileType type) noexcept {
+            bits |= bit(type);
+            return *this;
+        }
+        constexpr FileTypeSet &erase(FileType type) noexcept {
+            bits &= ~bit(type);
+            return *this;
+        }
+        constexpr bool contains(FileType type) const noexcept { return (bits & bit(type)) != 0; }
+        constexpr bool empty() const noexcept { return bits == 0; }
+
+        constexpr friend FileTypeSet operator|(FileTypeSet a, FileTypeSet b) noexcept {
+            a.bits |= b.bits;
+            return a;
+        }
+        constexpr friend FileTypeSet operator&(FileTypeSet a, FileTypeSet b) noexcept {
+            a.bits &= b.bits;
+            return a;
+        }
+        constexpr friend bool operator==(FileTypeSet a, FileTypeSet b) noexcept = default;
+    };
+
     /**
      * @namespace neko::util::detect::detail
      * @brief Contains implementation details for file type detection.
@@ -33,27 +151,69 @@ namespace neko::util::detect {
 
         /**
          * @brief Represents a file signature for type detection.
+         * Stored inline with fixed capacities, so the whole signature table is a compile-time constant.
          */
         struct FileSignature {
+            static constexpr std::size_t maxNames = 5;
+            static constexpr std::size_t maxMagic = 16;
+
             /**
              * @brief The possible types for the file.
              * @example "TXT", "EXE", "ZIP", "7Z" , etc.
              */
-            std::vector<std::string> types;
+            std::array<std::string_view, maxNames> typeList{};
             /**
              * @brief The magic number (file signature) for the file.
              */
-            std::vector<neko::uchar> magic;
+            std::array<neko::uchar, maxMagic> magicBytes{};
             /**
              * @brief The possible file extensions for the file.
              * @note This is used to match the file extension after the magic number is detected.
              *       If the magic number matches but the extension does not, it will not be considered a match.
              *       This helps avoid false positives for files with the same magic number but different extensions.
              */
-            std::vector<std::string> possibleExtensions;
+            std::array<std::string_view, maxNames> extensionList{};
+            /**
+             * @brief The FileType of each entry in typeList.
+             */
+            std::array<FileType, maxNames> typeIdList{};
+            std::size_t typeCount = 0;
+            std::size_t magicSize = 0;
+            std::size_t extensionCount = 0;
+
+            constexpr FileSignature(std::initializer_list<std::string_view> types, std::initializer_list<neko::uchar> magic,
+                                    std::initializer_list<std::string_view> possibleExtensions) {
+                // Exceeding a capacity indexes out of bounds, which fails the constant evaluation of the table
+                for (auto type : types) {
+                    typeIdList[typeCount] = fileTypeFromName(type);
+                    typeList[typeCount++] = type;
+                }
+                for (auto byte : magic)
+                    magicBytes[magicSize++] = byte;
+                for (auto ext : possibleExtensions)
+                    extensionList[extensionCount++] = ext;
+            }
+
+            constexpr std::span<const std::string_view> types() const noexcept { return {typeList.data(), typeCount}; }
+            constexpr std::span<const FileType> typeIds() const noexcept { return {typeIdList.data(), typeCount}; }
+            constexpr std::span<const neko::uchar> magic() const noexcept { return {magicBytes.data(), magicSize}; }
+            constexpr std::span<const std::string_view> possibleExtensions() const noexcept { return {extensionList.data(), extensionCount}; }
+
+            /**
+             * @brief Whether the buffer starts with this signature's magic number.
+             */
+            constexpr bool matches(const neko::uchar *buffer, std::size_t size) const noexcept {
+                if (magicSize == 0 || size < magicSize)
+                    return false;
+                for (std::size_t i = 0; i < magicSize; ++i) {
+                    if (buffer[i] != magicBytes[i])
+                        return false;
+                }
+                return true;
+            }
         };
 
-        const std::vector<FileSignature> signatures = {
+        inline constexpr FileSignature signatures[] = {
             // text files
             {{"TXT"}, {'T', 'E', 'X', 'T'}, {"txt"}},
             {{"CSV"}, {'C', 'S', 'V'}, {"csv"}},
@@ -109,51 +269,85 @@ namespace neko::util::detect {
             {{"SWF"}, {'C', 'W', 'S'}, {"swf"}},
             {{"SWF"}, {'Z', 'W', 'S'}, {"swf"}}};
 
+        inline constexpr std::size_t signatureCount = std::size(signatures);
+
         /**
-         * @brief Serialize magic number to string for map key.
+         * @brief Signatures grouped by the first byte of their magic number.
+         * Signatures whose magic starts with byte b are order[offsets[b]] to order[offsets[b + 1] - 1],
+         * in table order, so the first listed signature still wins when magic numbers overlap.
          */
-        inline std::string magicToKey(const std::vector<neko::uchar> &magic) {
-            std::ostringstream oss;
-            for (auto c : magic)
-                oss << std::setw(2) << std::setfill('0') << std::hex << static_cast<neko::uint32>(c);
-            return oss.str();
+        struct FirstByteIndex {
+            std::array<std::uint16_t, 257> offsets{};
+            std::array<std::uint16_t, signatureCount> order{};
+        };
+
+        consteval FirstByteIndex buildFirstByteIndex() {
+            FirstByteIndex index;
+            for (const auto &sig : signatures) {
+                if (sig.magicSize > 0)
+                    ++index.offsets[sig.magicBytes[0] + 1];
+            }
+            for (std::size_t b = 1; b < index.offsets.size(); ++b) {
+                index.offsets[b] += index.offsets[b - 1];
+            }
+            std::array<std::uint16_t, 256> fill{};
+            for (std::size_t i = 0; i < signatureCount; ++i) {
+                if (signatures[i].magicSize == 0)
+                    continue;
+                auto first = signatures[i].magicBytes[0];
+                index.order[index.offsets[first] + fill[first]++] = static_cast<std::uint16_t>(i);
+            }
+            return index;
         }
 
+        inline constexpr FirstByteIndex firstByteIndex = buildFirstByteIndex();
+
         /**
-         * @brief Get the extension to type mapping.
+         * @brief Find the signature matching the start of a buffer.
+         * Only the signatures sharing the buffer's first byte are compared.
+         * @return The matched signature, or nullptr if none matches.
          */
-        inline const std::unordered_map<std::string, std::string> &getExtensionTypeMap() {
-            static std::unordered_map<std::string, std::string> extTypeMap;
-            static bool initialized = false;
-            if (!initialized) {
-                for (const auto &sig : signatures) {
-                    for (size_t i = 0; i < sig.possibleExtensions.size(); ++i) {
-                        std::string ext = sig.possibleExtensions[i];
-                        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                        std::string type = (i < sig.types.size()) ? sig.types[i] : sig.types[0];
-                        extTypeMap[ext] = type;
-                    }
-                }
-                initialized = true;
+        constexpr const FileSignature *findSignature(const neko::uchar *buffer, std::size_t size) noexcept {
+            if (size == 0)
+                return nullptr;
+            const auto first = buffer[0];
+            for (auto i = firstByteIndex.offsets[first]; i < firstByteIndex.offsets[first + 1]; ++i) {
+                const auto &sig = signatures[firstByteIndex.order[i]];
+                if (sig.matches(buffer, size))
+                    return &sig;
             }
-            return extTypeMap;
+            return nullptr;
         }
 
         /**
-         * @brief Get the magic number to type mapping.
+         * @brief Get the extension to type mapping.
+         * Built once on first use; the initialization of the function-local static is thread-safe.
          */
-        inline const std::unordered_map<std::string, std::string> &getMagicTypeMap() {
-            static std::unordered_map<std::string, std::string> magicTypeMap;
-            static bool initialized = false;
-            if (!initialized) {
+        inline const std::unordered_map<std::string, FileType> &getExtensionTypeMap() {
+            static const std::unordered_map<std::string, FileType> extTypeMap = [] {
+                std::unordered_map<std::string, FileType> map;
                 for (const auto &sig : signatures) {
-                    if (!sig.magic.empty()) {
-                        magicTypeMap[magicToKey(sig.magic)] = sig.types[0];
+                    auto exts = sig.possibleExtensions();
+                    auto types = sig.typeIds();
+                    for (size_t i = 0; i < exts.size(); ++i) {
+                        std::string ext = util::string::toLowerAscii(exts[i]);
+                        map[ext] = i < types.size() ? types[i] : types[0];
                     }
                 }
-                initialized = true;
-            }
-            return magicTypeMap;
+                return map;
+            }();
+            return extTypeMap;
+        }
+
+        inline FileType idByExtension(const std::string &ext) {
+            auto &extTypeMap = getExtensionTypeMap();
+            auto it = extTypeMap.find(ext);
+            return it != extTypeMap.end() ? it->second : FileType::unknown;
+        }
+
+        inline FileType idByMagic(const neko::uchar *buffer, std::size_t size) noexcept {
+            const FileSignature *sig = findSignature(buffer, size);
+            return sig ? sig->typeIds()[0] : FileType::unknown;
         }
 
         /**
@@ -167,16 +361,12 @@ namespace neko::util::detect {
          * @see getExtensionTypeMap for the map of extensions to types.
          */
         inline std::string typeByExtension(const std::string &ext) {
-            auto &extTypeMap = getExtensionTypeMap();
-            auto it = extTypeMap.find(ext);
-            if (it != extTypeMap.end())
-                return it->second;
-            return "Unknown";
+            return std::string(fileTypeName(idByExtension(ext)));
         }
 
         /**
          * @brief Find type by magic number.
-         * This function checks the magic number of a file against a static map of known magic numbers and their types.
+         * This function compares the start of the buffer with the compile-time signature table, looking only at signatures that share its first byte.
          * If the magic number is found, it returns the corresponding type; otherwise, it returns "Unknown".
          * @param buffer Pointer to the buffer containing the file data.
          * @param size Size of the buffer in bytes.
@@ -185,65 +375,201 @@ namespace neko::util::detect {
          * @example For example, a buffer starting with {0xFF, 0xD8, 0xFF} returns "JPEG", while a buffer starting with
          */
         inline std::string typeByMagic(const neko::uchar *buffer, size_t size) {
-            auto &magicTypeMap = getMagicTypeMap();
-            for (const auto &sig : signatures) {
-                if (sig.magic.empty() || size < sig.magic.size())
-                    continue;
-                if (std::equal(sig.magic.begin(), sig.magic.end(), buffer)) {
-                    return sig.types[0];
-                }
-            }
-            return "Unknown";
+            return std::string(fileTypeName(idByMagic(buffer, size)));
+        }
+
+        // Number of leading bytes read to match magic numbers
+        inline constexpr std::size_t headerSize = 32;
+
+        /**
+         * @brief Read the first bytes of a file.
+         * Uses a single open/pread/close on POSIX systems rather than constructing a stream.
+         * Not mapped: for 32 bytes, setting up a MappedFile costs more system calls than the pread.
+         * @return The number of bytes read, or -1 if the file cannot be opened.
+         */
+        inline std::ptrdiff_t readHeader(const std::string &filename, neko::uchar *buffer, std::size_t size) {
+#if defined(__unix__) || defined(__APPLE__)
+            int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return -1;
+            ssize_t bytesRead = ::pread(fd, buffer, size, 0);
+            ::close(fd);
+            return bytesRead < 0 ? -1 : static_cast<std::ptrdiff_t>(bytesRead);
+#else
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.is_open())
+                return -1;
+            file.read(reinterpret_cast<char *>(buffer), static_cast<std::streamsize>(size));
+            return static_cast<std::ptrdiff_t>(file.gcount());
+#endif
+        }
+
+        /**
+         * @brief Classify a header by magic number first, then by extension.
+         * @param ext The lowercase extension, without the dot.
+         * @return The detected type, or FileType::unknown.
+         */
+        inline FileType classify(const neko::uchar *buffer, std::size_t size, const std::string &ext) {
+            FileType type = idByMagic(buffer, size);
+            return type != FileType::unknown ? type : idByExtension(ext);
+        }
+
+        inline std::string normalizeExtensionHint(std::string_view extensionHint) {
+            if (!extensionHint.empty() && extensionHint.front() == '.')
+                extensionHint.remove_prefix(1);
+            return util::string::toLowerAscii(extensionHint);
         }
 
     } // namespace detail
 
     /**
-     * @brief Detect the file type based on its content and extension.
-     * This function reads the first few bytes of a file to determine its type using magic numbers.
-     * If a magic number has multiple possible types (e.g., exe, dll), the function will try to determine the type using the file extension. Otherwise, it returns the first type.
+     * @brief Identify the file type based on its content and extension.
+     * Reads the first 32 bytes of the file and matches them against the known magic numbers,
+     * falling back to the extension when none matches.
      * @param filename The name of the file to check.
-     * @param noex If true, returns "Unknown" instead of throwing an exception if the file cannot be opened or no magic number matches.
-     * @return The detected file type as a string. e.g. "TXT", "PNG", "ZIP", "7Z", etc.
-     * @throws ex::FileError if the file cannot be opened or if no magic number matches
-     * @note The function reads up to 32 bytes from the file to check for magic numbers.
+     * @return The detected type, or FileType::unknown if the file cannot be read or classified.
      */
-    inline std::string detectFileType(const std::string &filename, bool noex = false) {
-        std::ifstream file(filename, std::ios::binary);
-        if (!file.is_open()) {
-            if (noex)
-                return "Unknown";
-            throw ex::FileError("Cannot open file: " + filename);
-        }
+    inline FileType identifyFileType(const std::string &filename) {
+        NEKO_FUNCTION_PROFILE_SCOPE(timer, "detect.identifyFileType");
+        neko::uchar buffer[detail::headerSize];
+        std::ptrdiff_t bytesRead = detail::readHeader(filename, buffer, sizeof(buffer));
+        if (bytesRead < 0)
+            return FileType::unknown;
+        NEKO_FUNCTION_PROFILE_BYTES(timer, bytesRead);
+        return detail::classify(buffer, static_cast<std::size_t>(bytesRead), util::string::getExtensionName(filename));
+    }
 
-        neko::uchar buffer[32] = {0};
-        file.read(reinterpret_cast<char *>(buffer), sizeof(buffer));
-        size_t bytesRead = file.gcount();
+    /**
+     * @brief Identify the type of data already in memory, such as a download buffer or an archive entry.
+     * @param data The content, or at least its first 32 bytes.
+     * @param extensionHint Extension used when no magic number matches, e.g. "json" or ".json" (optional).
+     * @return The detected type, or FileType::unknown if neither the content nor the hint matches.
+     */
+    inline FileType identifyFileType(std::span<const std::byte> data, std::string_view extensionHint = {}) {
+        return detail::classify(reinterpret_cast<const neko::uchar *>(data.data()), data.size(), detail::normalizeExtensionHint(extensionHint));
+    }
+
+    /**
+     * @brief Identify the type of a file that is already open, e.g. mapped for hashing or extraction.
+     * The header is read from the mapping in place, without opening the file again.
+     * @param file The opened file; a stream keeps the peeked header for its next read.
+     * @return The detected type, or FileType::unknown if neither the content nor the file extension matches.
+     * @throws ex::FileError if reading from a stream fails.
+     */
+    inline FileType identifyFileType(fs::MappedFile &file) {
+        auto header = file.peek(detail::headerSize);
+        return detail::classify(reinterpret_cast<const neko::uchar *>(header.data()), header.size(), util::string::getExtensionName(file.path()));
+    }
 
-        std::string ext = util::string::getExtensionName(filename);
+    /**
+     * @brief Identify the types of many files, reading their headers concurrently.
+     * Each header is read with a single pread where available, so large directory scans are bound by the disk
+     * rather than by stream construction.
+     * @param filenames The files to classify.
+     * @param threads Number of reading threads, 0 uses the hardware concurrency.
+     * @return One type per file, in the same order; FileType::unknown for files that cannot be read or classified.
+     */
+    inline std::vector<FileType> identifyFileTypes(std::span<const std::string> filenames, std::size_t threads = 0) {
+        if (filenames.empty())
+            return {};
+        std::vector<FileType> types(filenames.size(), FileType::unknown);
+        if (threads == 0)
+            threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        threads = std::min(threads, filenames.size());
 
-        // 1. Try magic number map
-        std::string type = detail::typeByMagic(buffer, bytesRead);
-        if (type != "Unknown")
-            return type;
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]() {
+            std::size_t i;
+            while ((i = next.fetch_add(1, std::memory_order_relaxed)) < filenames.size()) {
+                types[i] = identifyFileType(filenames[i]);
+            }
+        };
 
-        // 2. Try extension map
-        type = detail::typeByExtension(ext);
-        if (type != "Unknown")
-            return type;
+        pool::runWorkers(threads, [&](std::size_t) { worker(); });
+        return types;
+    }
 
-        if (noex)
-            return "Unknown";
+    /**
+     * @brief Identify the file type like identifyFileType, but with the errors of detectFileType.
+     * @param filename The name of the file to check.
+     * @return The detected type, never FileType::unknown.
+     * @throws ex::FileError if the file cannot be opened or if neither a magic number nor the extension matches.
+     */
+    inline FileType identifyKnownFileType(const std::string &filename) {
+        NEKO_FUNCTION_PROFILE_SCOPE(timer, "detect.detectFileType");
+        neko::uchar buffer[detail::headerSize] = {0};
+        std::ptrdiff_t bytesRead = detail::readHeader(filename, buffer, sizeof(buffer));
+        if (bytesRead < 0)
+            throw ex::FileError("Cannot open file: " + filename);
+        NEKO_FUNCTION_PROFILE_BYTES(timer, bytesRead);
+
+        // Magic number first, then extension
+        FileType type = detail::classify(buffer, static_cast<std::size_t>(bytesRead), util::string::getExtensionName(filename));
+        if (type != FileType::unknown)
+            return type;
 
         std::ostringstream oss;
         oss << "Unknown file type: " << std::uppercase << std::hex;
-        for (size_t i = 0; i < std::min(bytesRead, size_t(16)); ++i) {
+        for (std::ptrdiff_t i = 0; i < std::min<std::ptrdiff_t>(bytesRead, 16); ++i) {
             oss << std::setw(2) << std::setfill('0') << static_cast<neko::uint32>(buffer[i]) << ' ';
         }
 
         throw ex::FileError(oss.str());
     }
 
+    /**
+     * @brief Detect the file type based on its content and extension.
+     * This function reads the first few bytes of a file to determine its type using magic numbers.
+     * If a magic number has multiple possible types (e.g., exe, dll), the function will try to determine the type using the file extension. Otherwise, it returns the first type.
+     * @param filename The name of the file to check.
+     * @param noex If true, returns "Unknown" instead of throwing an exception if the file cannot be opened or no magic number matches.
+     * @return The detected file type as a string. e.g. "TXT", "PNG", "ZIP", "7Z", etc.
+     * @throws ex::FileError if the file cannot be opened or if no magic number matches
+     * @note The function reads up to 32 bytes from the file to check for magic numbers.
+     * @see identifyFileType for the allocation-free FileType result.
+     */
+    inline std::string detectFileType(const std::string &filename, bool noex = false) {
+        if (noex)
+            return std::string(fileTypeName(identifyFileType(filename)));
+        return std::string(fileTypeName(identifyKnownFileType(filename)));
+    }
+
+    /**
+     * @brief Detect the type of data already in memory, such as a download buffer or an archive entry.
+     * @param data The content, or at least its first 32 bytes.
+     * @param extensionHint Extension used when no magic number matches, e.g. "json" or ".json" (optional).
+     * @return The detected file type as a string, or "Unknown" if neither the content nor the hint matches.
+     */
+    inline std::string detectFileType(std::span<const std::byte> data, std::string_view extensionHint = {}) {
+        return std::string(fileTypeName(identifyFileType(data, extensionHint)));
+    }
+
+    /**
+     * @brief Detect the types of many files, reading their headers concurrently.
+     * @param filenames The files to classify.
+     * @param threads Number of reading threads, 0 uses the hardware concurrency.
+     * @return One type per file, in the same order; "Unknown" for files that cannot be read or classified.
+     * @see identifyFileTypes for FileType results.
+     */
+    inline std::vector<std::string> detectFileTypes(std::span<const std::string> filenames, std::size_t threads = 0) {
+        std::vector<std::string> names;
+        names.reserve(filenames.size());
+        for (FileType type : identifyFileTypes(filenames, threads)) {
+            names.emplace_back(fileTypeName(type));
+        }
+        return names;
+    }
+
+    /**
+     * @brief Check if a file is one of a set of types.
+     * @param filename The name of the file to check.
+     * @param targetTypes The accepted types, e.g. FileTypeSet{FileType::png, FileType::jpeg}.
+     * @return True if the file's type is in the set; false otherwise, including when it cannot be read or classified.
+     */
+    inline bool isTargetFileType(const std::string &filename, FileTypeSet targetTypes) {
+        return targetTypes.contains(identifyFileType(filename));
+    }
+
     /**
      * @brief Check if a file is of a specific type based on its filename and extension.
      * This function checks if the file's extension matches any of the target types.
@@ -252,19 +578,18 @@ namespace neko::util::detect {
      * For example, {"TXT", "CSV"} to check if the file is a text or CSV file.
      * @param caseSensitive Whether to perform case-sensitive matching. Default is false.
      * @return True if the file's type matches any of the target types, false otherwise.
+     * @throws ex::FileError if the file cannot be opened or its type is unknown.
      */
     inline bool isTargetFileType(const std::string &filename, const std::vector<std::string> &targetType, bool caseSensitive = false) {
         std::string detectedType = detectFileType(filename);
-        if (!caseSensitive) {
-            std::transform(detectedType.begin(), detectedType.end(), detectedType.begin(), ::toupper);
+        if (caseSensitive)
+            return std::find(targetType.begin(), targetType.end(), detectedType) != targetType.end();
+
+        FileTypeSet targets;
+        for (const auto &type : targetType) {
+            targets.insert(fileTypeFromName(type));
         }
-        return std::find_if(targetType.begin(), targetType.end(), [&](const std::string &type) {
-            std::string target = type;
-            if (!caseSensitive) {
-                std::transform(target.begin(), target.end(), target.begin(), ::toupper);
-            }
-            return detectedType == target;
-        }) != targetType.end();
+        return targets.contains(fileTypeFromName(detectedType));
     }
 
 } // namespace neko::util::detect
@@ -0,0 +1,894 @@
+/**
+ * @file fastHash.hpp
+ * @brief Non-cryptographic hash and checksum implementations (CRC32, CRC32C, XXH3, BLAKE3)
+ * @author moehoshio
+ * @copyright Copyright (c) 2025 Hoshi
+ * @license MIT OR Apache-2.0
+ *
+ * These algorithms have no external dependencies and are available without OpenSSL.
+ * They are normally used through neko::util::hash::digest / digestFile / Hasher.
+ */
+
+#pragma once
+
+// Include header for non-module usage
+#if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+#endif // NEKO_FUNCTION_ENABLE_MODULE
+
+namespace neko::util::hash {
+
+    /**
+     * @namespace neko::util::hash::detail
+     * @brief Implementation details of the hash algorithms.
+     */
+    namespace detail {
+
+        inline std::uint32_t readLE32(const unsigned char *p) noexcept {
+            return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+                   (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+        }
+
+        inline std::uint64_t readLE64(const unsigned char *p) noexcept {
+            return static_cast<std::uint64_t>(readLE32(p)) | (static_cast<std::uint64_t>(readLE32(p + 4)) << 32);
+        }
+
+        inline void writeBE32(unsigned char *p, std::uint32_t v) noexcept {
+            p[0] = static_cast<unsigned char>(v >> 24);
+            p[1] = static_cast<unsigned char>(v >> 16);
+            p[2] = static_cast<unsigned char>(v >> 8);
+            p[3] = static_cast<unsigned char>(v);
+        }
+
+        inline void writeBE64(unsigned char *p, std::uint64_t v) noexcept {
+            writeBE32(p, static_cast<std::uint32_t>(v >> 32));
+            writeBE32(p + 4, static_cast<std::uint32_t>(v));
+        }
+
+        constexpr std::uint32_t rotl32(std::uint32_t v, int r) noexcept {
+            return (v << r) | (v >> (32 - r));
+        }
+
+        constexpr std::uint32_t rotr32(std::uint32_t v, int r) noexcept {
+            return (v >> r) | (v << (32 - r));
+        }
+
+        constexpr std::uint64_t rotl64(std::uint64_t v, int r) noexcept {
+            return (v << r) | (v >> (64 - r));
+        }
+
+        constexpr std::uint32_t swap32(std::uint32_t v) noexcept {
+            return ((v << 24) & 0xff000000) | ((v << 8) & 0x00ff0000) | ((v >> 8) & 0x0000ff00) | ((v >> 24) & 0x000000ff);
+        }
+
+        constexpr std::uint64_t swap64(std::uint64_t v) noexcept {
+            return (static_cast<std::uint64_t>(swap32(static_cast<std::uint32_t>(v))) << 32) | swap32(static_cast<std::uint32_t>(v >> 32));
+        }
+
+        // ===================
+        // ====== CRC32 ======
+        // ===================
+
+        /**
+         * @brief Builds slicing-by-8 lookup tables for a reflected CRC32 polynomial.
+         */
+        constexpr std::array<std::array<std::uint32_t, 256>, 8> makeCrcTables(std::uint32_t poly) {
+            std::array<std::array<std::uint32_t, 256>, 8> tables{};
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t crc = i;
+                for (int k = 0; k < 8; ++k) {
+                    crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+                }
+                tables[0][i] = crc;
+            }
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                for (std::size_t t = 1; t < 8; ++t) {
+                    tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+                }
+            }
+            return tables;
+        }
+
+        /// CRC-32 (ISO-HDLC, as used by zip, gzip and png)
+        inline constexpr auto crc32Tables = makeCrcTables(0xEDB88320u);
+        /// CRC-32C (Castagnoli, as used by iSCSI, ext4 and SSE4.2)
+        inline constexpr auto crc32cTables = makeCrcTables(0x82F63B78u);
+
+        /**
+         * @brief Software slicing-by-8 CRC update on the raw (non-inverted) register.
+         */
+        inline std::uint32_t crcSoftware(const std::array<std::array<std::uint32_t, 256>, 8> &t, std::uint32_t crc, const unsigned char *data, std::size_t size) noexcept {
+            while (size >= 8) {
+                std::uint32_t lo = readLE32(data) ^ crc;
+                std::uint32_t hi = readLE32(data + 4);
+                crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                      t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+                data += 8;
+                size -= 8;
+            }
+            while (size--) {
+                crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+            }
+            return crc;
+        }
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        /**
+         * @brief Checks once whether the CPU supports the SSE4.2 CRC32 instruction.
+         */
+        inline bool cpuHasSse42() noexcept {
+            static const bool supported = [] {
+#if defined(_MSC_VER)
+                int info[4] = {0};
+                __cpuid(info, 1);
+                return (info[2] & (1 << 20)) != 0;
+#else
+                return __builtin_cpu_supports("sse4.2") != 0;
+#endif
+            }();
+            return supported;
+        }
+
+#if !defined(_MSC_VER)
+        __attribute__((target("sse4.2")))
+#endif
+        inline std::uint32_t
+        crc32cHardware(std::uint32_t crc, const unsigned char *data, std::size_t size) noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+            std::uint64_t c = crc;
+            while (size >= 8) {
+                std::uint64_t v;
+                std::memcpy(&v, data, 8);
+                c = _mm_crc32_u64(c, v);
+                data += 8;
+                size -= 8;
+            }
+            crc = static_cast<std::uint32_t>(c);
+#endif
+            while (size >= 4) {
+                std::uint32_t v;
+                std::memcpy(&v, data, 4);
+                crc = _mm_crc32_u32(crc, v);
+                data += 4;
+                size -= 4;
+            }
+            while (size--) {
+                crc = _mm_crc32_u8(crc, *data++);
+            }
+            return crc;
+        }
+#endif // x86
+
+        /**
+         * @brief Updates a CRC-32C register, using SSE4.2 or ARMv8 CRC instructions when available.
+         */
+        inline std::uint32_t crc32cUpdate(std::uint32_t crc, const unsigned char *data, std::size_t size) noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            if (cpuHasSse42()) {
+                return crc32cHardware(crc, data, size);
+            }
+#elif defined(__ARM_FEATURE_CRC32)
+            while (size >= 8) {
+                std::uint64_t v;
+                std::memcpy(&v, data, 8);
+                crc = __crc32cd(crc, v);
+                data += 8;
+                size -= 8;
+            }
+            while (size--) {
+                crc = __crc32cb(crc, *data++);
+            }
+            return crc;
+#endif
+            return crcSoftware(crc32cTables, crc, data, size);
+        }
+
+        /**
+         * @brief Updates a CRC-32 register, using ARMv8 CRC instructions when available.
+         */
+        inline std::uint32_t crc32Update(std::uint32_t crc, const unsigned char *data, std::size_t size) noexcept {
+#if defined(__ARM_FEATURE_CRC32)
+            while (size >= 8) {
+                std::uint64_t v;
+                std::memcpy(&v, data, 8);
+                crc = __crc32d(crc, v);
+                data += 8;
+                size -= 8;
+            }
+            while (size--) {
+                crc = __crc32b(crc, *data++);
+            }
+            return crc;
+#else
+            return crcSoftware(crc32Tables, crc, data, size);
+#endif
+        }
+
+        // ==================
+        // ====== XXH3 ======
+        // ==================
+
+        namespace xxh3 {
+            constexpr std::uint32_t prime32_1 = 0x9E3779B1U;
+            constexpr std::uint32_t prime32_2 = 0x85EBCA77U;
+            constexpr std::uint32_t prime32_3 = 0xC2B2AE3DU;
+            constexpr std::uint64_t prime64_1 = 0x9E3779B185EBCA87ULL;
+            constexpr std::uint64_t prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+            constexpr std::uint64_t prime64_3 = 0x165667B19E3779F9ULL;
+            constexpr std::uint64_t prime64_4 = 0x85EBCA77C2B2AE63ULL;
+            constexpr std::uint64_t prime64_5 = 0x27D4EB2F165667C5ULL;
+            constexpr std::uint64_t primeMx1 = 0x165667919E3779F9ULL;
+            constexpr std::uint64_t primeMx2 = 0x9FB21C651E98DF25ULL;
+
+            constexpr std::size_t stripeLen = 64;
+            constexpr std::size_t secretConsumeRate = 8;
+            constexpr std::size_t accNb = 8;
+            constexpr std::size_t secretSizeMin = 136;
+            constexpr std::size_t midSizeMax = 240;
+            constexpr std::size_t midSizeStartOffset = 3;
+            constexpr std::size_t midSizeLastOffset = 17;
+            constexpr std::size_t secretLastAccStart = 7;
+            constexpr std::size_t secretMergeAccsStart = 11;
+            constexpr std::size_t internalBufferSize = 256;
+
+            /// Default secret (taken from FARSH, as in the reference implementation)
+            alignas(64) inline constexpr unsigned char kSecret[192] = {
+                0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+                0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+                0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+                0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+                0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+                0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+                0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+                0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+                0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+                0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+                0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+                0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+            };
+            constexpr std::size_t secretSize = sizeof(kSecret);
+            constexpr std::size_t secretLimit = secretSize - stripeLen;
+            constexpr std::size_t stripesPerBlock = secretLimit / secretConsumeRate;
+
+            struct Hash128 {
+                std::uint64_t low64;
+                std::uint64_t high64;
+            };
+
+            inline Hash128 mult64to128(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+#if defined(__SIZEOF_INT128__)
+                unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+                return {static_cast<std::uint64_t>(product), static_cast<std::uint64_t>(product >> 64)};
+#else
+                std::uint64_t loLo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+                std::uint64_t hiLo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+                std::uint64_t loHi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+                std::uint64_t hiHi = (lhs >> 32) * (rhs >> 32);
+                std::uint64_t cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+                std::uint64_t upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+                std::uint64_t lower = (cross << 32) | (loLo & 0xFFFFFFFF);
+                return {lower, upper};
+#endif
+            }
+
+            inline std::uint64_t mul128Fold64(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+                Hash128 product = mult64to128(lhs, rhs);
+                return product.low64 ^ product.high64;
+            }
+
+            constexpr std::uint64_t xorshift64(std::uint64_t v, int shift) noexcept {
+                return v ^ (v >> shift);
+            }
+
+            constexpr std::uint64_t xxh64Avalanche(std::uint64_t h) noexcept {
+                h ^= h >> 33;
+                h *= prime64_2;
+                h ^= h >> 29;
+                h *= prime64_3;
+                h ^= h >> 32;
+                return h;
+            }
+
+            constexpr std::uint64_t avalanche(std::uint64_t h) noexcept {
+                h = xorshift64(h, 37);
+                h *= primeMx1;
+                h = xorshift64(h, 32);
+                return h;
+            }
+
+            constexpr std::uint64_t rrmxmx(std::uint64_t h, std::uint64_t len) noexcept {
+                h ^= rotl64(h, 49) ^ rotl64(h, 24);
+                h *= primeMx2;
+                h ^= (h >> 35) + len;
+                h *= primeMx2;
+                return xorshift64(h, 28);
+            }
+
+            inline std::uint64_t mix16B(const unsigned char *input, const unsigned char *secret) noexcept {
+                return mul128Fold64(readLE64(input) ^ readLE64(secret), readLE64(input + 8) ^ readLE64(secret + 8));
+            }
+
+            // ---- 64-bit short inputs ----
+
+            inline std::uint64_t len0to16_64(const unsigned char *input, std::size_t len) noexcept {
+                const unsigned char *secret = kSecret;
+                if (len > 8) {
+                    std::uint64_t bitflip1 = readLE64(secret + 24) ^ readLE64(secret + 32);
+                    std::uint64_t bitflip2 = readLE64(secret + 40) ^ readLE64(secret + 48);
+                    std::uint64_t inputLo = readLE64(input) ^ bitflip1;
+                    std::uint64_t inputHi = readLE64(input + len - 8) ^ bitflip2;
+                    std::uint64_t acc = len + swap64(inputLo) + inputHi + mul128Fold64(inputLo, inputHi);
+                    return avalanche(acc);
+                }
+                if (len >= 4) {
+                    std::uint32_t input1 = readLE32(input);
+                    std::uint32_t input2 = readLE32(input + len - 4);
+                    std::uint64_t bitflip = readLE64(secret + 8) ^ readLE64(secret + 16);
+                    std::uint64_t input64 = input2 + (static_cast<std::uint64_t>(input1) << 32);
+                    return rrmxmx(input64 ^ bitflip, len);
+                }
+                if (len > 0) {
+                    std::uint32_t combined = (static_cast<std::uint32_t>(input[0]) << 16) | (static_cast<std::uint32_t>(input[len >> 1]) << 24) |
+                                             static_cast<std::uint32_t>(input[len - 1]) | (static_cast<std::uint32_t>(len) << 8);
+                    std::uint64_t bitflip = readLE32(secret) ^ readLE32(secret + 4);
+                    return xxh64Avalanche(static_cast<std::uint64_t>(combined) ^ bitflip);
+                }
+                return xxh64Avalanche(readLE64(secret + 56) ^ readLE64(secret + 64));
+            }
+
+            inline std::uint64_t len17to128_64(const unsigned char *input, std::size_t len) noexcept {
+                const unsigned char *secret = kSecret;
+                std::uint64_t acc = len * prime64_1;
+                if (len > 32) {
+                    if (len > 64) {
+                        if (len > 96) {
+                            acc += mix16B(input + 48, secret + 96);
+                            acc += mix16B(input + len - 64, secret + 112);
+                        }
+                        acc += mix16B(input + 32, secret + 64);
+                        acc += mix16B(input + len - 48, secret + 80);
+                    }
+                    acc += mix16B(input + 16, secret + 32);
+                    acc += mix16B(input + len - 32, secret + 48);
+                }
+                acc += mix16B(input, secret);
+                acc += mix16B(input + len - 16, secret + 16);
+                return avalanche(acc);
+            }
+
+            inline std::uint64_t len129to240_64(const unsigned char *input, std::size_t len) noexcept {
+                const unsigned char *secret = kSecret;
+                std::uint64_t acc = len * prime64_1;
+                std::size_t nbRounds = len / 16;
+                for (std::size_t i = 0; i < 8; ++i) {
+                    acc += mix16B(input + 16 * i, secret + 16 * i);
+                }
+                std::uint64_t accEnd = mix16B(input + len - 16, secret + secretSizeMin - midSizeLastOffset);
+                acc = avalanche(acc);
+                for (std::size_t i = 8; i < nbRounds; ++i) {
+                    accEnd += mix16B(input + 16 * i, secret + 16 * (i - 8) + midSizeStartOffset);
+                }
+                return avalanche(acc + accEnd);
+            }
+
+            inline std::uint64_t hashShort64(const unsigned char *input, std::size_t len) noexcept {
+                if (len <= 16) {
+                    return len0to16_64(input, len);
+                }
+                if (len <= 128) {
+                    return len17to128_64(input, len);
+                }
+                return len129to240_64(input, len);
+            }
+
+            // ---- 128-bit short inputs ----
+
+            inline Hash128 mix32B(Hash128 acc, const unsigned char *input1, const unsigned char *input2, const unsigned char *secret, std::uint64_t seed) noexcept {
+                auto mix = [seed](const unsigned char *in, const unsigned char *sec) {
+                    return mul128Fold64(readLE64(in) ^ (readLE64(sec) + seed), readLE64(in + 8) ^ (readLE64(sec + 8) - seed));
+                };
+                acc.low64 += mix(input1, secret);
+                acc.low64 ^= readLE64(input2) + readLE64(input2 + 8);
+                acc.high64 += mix(input2, secret + 16);
+                acc.high64 ^= readLE64(input1) + readLE64(input1 + 8);
+                return acc;
+            }
+
+            inline Hash128 len0to16_128(const unsigned char *input, std::size_t len) noexcept {
+                const unsigned char *secret = kSecret;
+                if (len > 8) {
+                    std::uint64_t bitflipl = readLE64(secret + 32) ^ readLE64(secret + 40);
+                    std::uint64_t bitfliph = readLE64(secret + 48) ^ readLE64(secret + 56);
+                    std::uint64_t inputLo = readLE64(input);
+                    std::uint64_t inputHi = readLE64(input + len - 8);
+                    Hash128 m128 = mult64to128(inputLo ^ inputHi ^ bitflipl, prime64_1);
+                    m128.low64 += static_cast<std::uint64_t>(len - 1) << 54;
+                    inputHi ^= bitfliph;
+                    if constexpr (sizeof(void *) < sizeof(std::uint64_t)) {
+                        m128.high64 += (inputHi & 0xFFFFFFFF00000000ULL) + static_cast<std::uint64_t>(static_cast<std::uint32_t>(inputHi)) * prime32_2;
+                    } else {
+                        m128.high64 += inputHi + static_cast<std::uint64_t>(static_cast<std::uint32_t>(inputHi)) * (prime32_2 - 1);
+                    }
+                    m128.low64 ^= swap64(m128.high64);
+                    Hash128 h128 = mult64to128(m128.low64, prime64_2);
+                    h128.high64 += m128.high64 * prime64_2;
+                    h128.low64 = avalanche(h128.low64);
+                    h128.high64 = avalanche(h128.high64);
+                    return h128;
+                }
+                if (len >= 4) {
+                    std::uint32_t inputLo = readLE32(input);
+                    std::uint32_t inputHi = readLE32(input + len - 4);
+                    std::uint64_t input64 = inputLo + (static_cast<std::uint64_t>(inputHi) << 32);
+                    std::uint64_t bitflip = readLE64(secret + 16) ^ readLE64(secret + 24);
+                    Hash128 m128 = mult64to128(input64 ^ bitflip, prime64_1 + (len << 2));
+                    m128.high64 += (m128.low64 << 1);
+                    m128.low64 ^= (m128.high64 >> 3);
+                    m128.low64 = xorshift64(m128.low64, 35);
+                    m128.low64 *= primeMx2;
+                    m128.low64 = xorshift64(m128.low64, 28);
+                    m128.high64 = avalanche(m128.high64);
+                    return m128;
+                }
+                if (len > 0) {
+                    std::uint32_t combinedl = (static_cast<std::uint32_t>(input[0]) << 16) | (static_cast<std::uint32_t>(input[len >> 1]) << 24) |
+                                              static_cast<std::uint32_t>(input[len - 1]) | (static_cast<std::uint32_t>(len) << 8);
+                    std::uint32_t combinedh = rotl32(swap32(combinedl), 13);
+                    std::uint64_t bitflipl = readLE32(secret) ^ readLE32(secret + 4);
+                    std::uint64_t bitfliph = readLE32(secret + 8) ^ readLE32(secret + 12);
+                    return {xxh64Avalanche(static_cast<std::uint64_t>(combinedl) ^ bitflipl),
+                            xxh64Avalanche(static_cast<std::uint64_t>(combinedh) ^ bitfliph)};
+                }
+                return {xxh64Avalanche(readLE64(secret + 64) ^ readLE64(secret + 72)),
+                        xxh64Avalanche(readLE64(secret + 80) ^ readLE64(secret + 88))};
+            }
+
+            inline Hash128 finish128(Hash128 acc, std::size_t len) noexcept {
+                Hash128 h128;
+                h128.low64 = acc.low64 + acc.high64;
+                h128.high64 = (acc.low64 * prime64_1) + (acc.high64 * prime64_4) + (len * prime64_2);
+                h128.low64 = avalanche(h128.low64);
+                h128.high64 = 0 - avalanche(h128.high64);
+                return h128;
+            }
+
+            inline Hash128 len17to128_128(const unsigned char *input, std::size_t len) noexcept {
+                const unsigned char *secret = kSecret;
+                Hash128 acc{len * prime64_1, 0};
+                if (len > 32) {
+                    if (len > 64) {
+                        if (len > 96) {
+                            acc = mix32B(acc, input + 48, input + len - 64, secret + 96, 0);
+                        }
+                        acc = mix32B(acc, input + 32, input + len - 48, secret + 64, 0);
+                    }
+                    acc = mix32B(acc, input + 16, input + len - 32, secret + 32, 0);
+                }
+                acc = mix32B(acc, input, input + len - 16, secret, 0);
+                return finish128(acc, len);
+            }
+
+            inline Hash128 len129to240_128(const unsigned char *input, std::size_t len) noexcept {
+                const unsigned char *secret = kSecret;
+                Hash128 acc{len * prime64_1, 0};
+                for (std::size_t i = 32; i < 160; i += 32) {
+                    acc = mix32B(acc, input + i - 32, input + i - 16, secret + i - 32, 0);
+                }
+                acc.low64 = avalanche(acc.low64);
+                acc.high64 = avalanche(acc.high64);
+                for (std::size_t i = 160; i <= len; i += 32) {
+                    acc = mix32B(acc, input + i - 32, input + i - 16, secret + midSizeStartOffset + i - 160, 0);
+                }
+                acc = mix32B(acc, input + len - 16, input + len - 32, secret + secretSizeMin - midSizeLastOffset - 16, 0);
+                return finish128(acc, len);
+            }
+
+            inline Hash128 hashShort128(const unsigned char *input, std::size_t len) noexcept {
+                if (len <= 16) {
+                    return len0to16_128(input, len);
+                }
+                if (len <= 128) {
+                    return len17to128_128(input, len);
+                }
+                return len129to240_128(input, len);
+            }
+
+            // ---- long inputs ----
+
+            inline void accumulate512(std::uint64_t *acc, const unsigned char *input, const unsigned char *secret) noexcept {
+                for (std::size_t lane = 0; lane < accNb; ++lane) {
+                    std::uint64_t dataVal = readLE64(input + lane * 8);
+                    std::uint64_t dataKey = dataVal ^ readLE64(secret + lane * 8);
+                    acc[lane ^ 1] += dataVal;
+                    acc[lane] += (dataKey & 0xFFFFFFFF) * (dataKey >> 32);
+                }
+            }
+
+            inline void accumulate(std::uint64_t *acc, const unsigned char *input, const unsigned char *secret, std::size_t nbStripes) noexcept {
+                for (std::size_t n = 0; n < nbStripes; ++n) {
+                    accumulate512(acc, input + n * stripeLen, secret + n * secretConsumeRate);
+                }
+            }
+
+            inline void scrambleAcc(std::uint64_t *acc, const unsigned char *secret) noexcept {
+                for (std::size_t lane = 0; lane < accNb; ++lane) {
+                    std::uint64_t acc64 = acc[lane];
+                    acc64 = xorshift64(acc64, 47);
+                    acc64 ^= readLE64(secret + lane * 8);
+                    acc64 *= prime32_1;
+                    acc[lane] = acc64;
+                }
+            }
+
+            inline std::uint64_t mergeAccs(const std::uint64_t *acc, const unsigned char *secret, std::uint64_t start) noexcept {
+                std::uint64_t result = start;
+                for (std::size_t i = 0; i < 4; ++i) {
+                    result += mul128Fold64(acc[2 * i] ^ readLE64(secret + 16 * i), acc[2 * i + 1] ^ readLE64(secret + 16 * i + 8));
+                }
+                return avalanche(result);
+            }
+
+            inline const unsigned char *consumeStripes(std::uint64_t *acc, std::size_t &nbStripesSoFar, const unsigned char *input, std::size_t nbStripes) noexcept {
+                const unsigned char *secret = kSecret;
+                const unsigned char *initialSecret = secret + nbStripesSoFar * secretConsumeRate;
+                if (nbStripes >= stripesPerBlock - nbStripesSoFar) {
+                    std::size_t nbStripesThisIter = stripesPerBlock - nbStripesSoFar;
+                    do {
+                        accumulate(acc, input, initialSecret, nbStripesThisIter);
+                        scrambleAcc(acc, secret + secretLimit);
+                        input += nbStripesThisIter * stripeLen;
+                        nbStripes -= nbStripesThisIter;
+                        nbStripesThisIter = stripesPerBlock;
+                        initialSecret = secret;
+                    } while (nbStripes >= stripesPerBlock);
+                    nbStripesSoFar = 0;
+                }
+                if (nbStripes > 0) {
+                    accumulate(acc, input, initialSecret, nbStripes);
+                    input += nbStripes * stripeLen;
+                    nbStripesSoFar += nbStripes;
+                }
+                return input;
+            }
+        } // namespace xxh3
+
+        /**
+         * @brief Streaming XXH3 state (default secret, seed 0), shared by the 64 and 128-bit variants.
+         */
+        class Xxh3State {
+        public:
+            Xxh3State() noexcept {
+                reset();
+            }
+
+            void reset() noexcept {
+                acc = {xxh3::prime32_3, xxh3::prime64_1, xxh3::prime64_2, xxh3::prime64_3,
+                       xxh3::prime64_4, xxh3::prime32_2, xxh3::prime64_5, xxh3::prime32_1};
+                totalLen = 0;
+                bufferedSize = 0;
+                nbStripesSoFar = 0;
+            }
+
+            void update(const unsigned char *input, std::size_t len) noexcept {
+                if (len == 0) {
+                    return;
+                }
+                const unsigned char *const bEnd = input + len;
+                totalLen += len;
+
+                if (len <= xxh3::internalBufferSize - bufferedSize) {
+                    std::memcpy(buffer.data() + bufferedSize, input, len);
+                    bufferedSize += len;
+                    return;
+                }
+
+                constexpr std::size_t bufferStripes = xxh3::internalBufferSize / xxh3::stripeLen;
+                if (bufferedSize) {
+                    std::size_t loadSize = xxh3::internalBufferSize - bufferedSize;
+                    std::memcpy(buffer.data() + bufferedSize, input, loadSize);
+                    input += loadSize;
+                    xxh3::consumeStripes(acc.data(), nbStripesSoFar, buffer.data(), bufferStripes);
+                    bufferedSize = 0;
+                }
+                if (static_cast<std::size_t>(bEnd - input) > xxh3::internalBufferSize) {
+                    std::size_t nbStripes = static_cast<std::size_t>(bEnd - 1 - input) / xxh3::stripeLen;
+                    input = xxh3::consumeStripes(acc.data(), nbStripesSoFar, input, nbStripes);
+                    std::memcpy(buffer.data() + buffer.size() - xxh3::stripeLen, input - xxh3::stripeLen, xxh3::stripeLen);
+                }
+                std::memcpy(buffer.data(), input, static_cast<std::size_t>(bEnd - input));
+                bufferedSize = static_cast<std::size_t>(bEnd - input);
+            }
+
+            std::uint64_t digest64() const noexcept {
+                if (totalLen > xxh3::midSizeMax) {
+                    std::array<std::uint64_t, xxh3::accNb> a;
+                    digestLong(a.data());
+                    return xxh3::mergeAccs(a.data(), xxh3::kSecret + xxh3::secretMergeAccsStart, totalLen * xxh3::prime64_1);
+                }
+                return xxh3::hashShort64(buffer.data(), static_cast<std::size_t>(totalLen));
+            }
+
+            xxh3::Hash128 digest128() const noexcept {
+                if (totalLen > xxh3::midSizeMax) {
+                    std::array<std::uint64_t, xxh3::accNb> a;
+                    digestLong(a.data());
+                    return {xxh3::mergeAccs(a.data(), xxh3::kSecret + xxh3::secretMergeAccsStart, totalLen * xxh3::prime64_1),
+                            xxh3::mergeAccs(a.data(), xxh3::kSecret + xxh3::secretSize - sizeof(a) - xxh3::secretMergeAccsStart, ~(totalLen * xxh3::prime64_2))};
+                }
+                return xxh3::hashShort128(buffer.data(), static_cast<std::size_t>(totalLen));
+            }
+
+        private:
+            void digestLong(std::uint64_t *out) const noexcept {
+                std::copy(acc.begin(), acc.end(), out);
+                unsigned char lastStripe[xxh3::stripeLen];
+                const unsigned char *lastStripePtr;
+                if (bufferedSize >= xxh3::stripeLen) {
+                    std::size_t nbStripes = (bufferedSize - 1) / xxh3::stripeLen;
+                    std::size_t stripesSoFar = nbStripesSoFar;
+                    xxh3::consumeStripes(out, stripesSoFar, buffer.data(), nbStripes);
+                    lastStripePtr = buffer.data() + bufferedSize - xxh3::stripeLen;
+                } else {
+                    std::size_t catchupSize = xxh3::stripeLen - bufferedSize;
+                    std::memcpy(lastStripe, buffer.data() + buffer.size() - catchupSize, catchupSize);
+                    std::memcpy(lastStripe + catchupSize, buffer.data(), bufferedSize);
+                    lastStripePtr = lastStripe;
+                }
+                xxh3::accumulate512(out, lastStripePtr, xxh3::kSecret + xxh3::secretLimit - xxh3::secretLastAccStart);
+            }
+
+            alignas(64) std::array<std::uint64_t, xxh3::accNb> acc{};
+            alignas(64) std::array<unsigned char, xxh3::internalBufferSize> buffer{};
+            std::uint64_t totalLen = 0;
+            std::size_t bufferedSize = 0;
+            std::size_t nbStripesSoFar = 0;
+        };
+
+        // ====================
+        // ====== BLAKE3 ======
+        // ====================
+
+        namespace blake3 {
+            constexpr std::size_t blockLen = 64;
+            constexpr std::size_t chunkLen = 1024;
+            constexpr std::size_t outLen = 32;
+            constexpr std::size_t maxDepth = 54;
+
+            constexpr std::uint32_t chunkStart = 1 << 0;
+            constexpr std::uint32_t chunkEnd = 1 << 1;
+            constexpr std::uint32_t parent = 1 << 2;
+            constexpr std::uint32_t root = 1 << 3;
+
+            inline constexpr std::array<std::uint32_t, 8> iv = {
+                0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+
+            inline constexpr std::array<std::uint8_t, 16> msgPermutation = {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8};
+
+            using Words8 = std::array<std::uint32_t, 8>;
+            using Words16 = std::array<std::uint32_t, 16>;
+
+            inline void g(Words16 &s, std::size_t a, std::size_t b, std::size_t c, std::size_t d, std::uint32_t mx, std::uint32_t my) noexcept {
+                s[a] = s[a] + s[b] + mx;
+                s[d] = rotr32(s[d] ^ s[a], 16);
+                s[c] = s[c] + s[d];
+                s[b] = rotr32(s[b] ^ s[c], 12);
+                s[a] = s[a] + s[b] + my;
+                s[d] = rotr32(s[d] ^ s[a], 8);
+                s[c] = s[c] + s[d];
+                s[b] = rotr32(s[b] ^ s[c], 7);
+            }
+
+            /**
+             * @brief The BLAKE3 compression function, returns the first 8 output words.
+             */
+            inline Words8 compress(const Words8 &cv, const Words16 &blockWords, std::uint64_t counter, std::uint32_t len, std::uint32_t flags) noexcept {
+                Words16 s = {cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+                             iv[0], iv[1], iv[2], iv[3],
+                             static_cast<std::uint32_t>(counter), static_cast<std::uint32_t>(counter >> 32), len, flags};
+                Words16 m = blockWords;
+                for (int r = 0; r < 7; ++r) {
+                    g(s, 0, 4, 8, 12, m[0], m[1]);
+                    g(s, 1, 5, 9, 13, m[2], m[3]);
+                    g(s, 2, 6, 10, 14, m[4], m[5]);
+                    g(s, 3, 7, 11, 15, m[6], m[7]);
+                    g(s, 0, 5, 10, 15, m[8], m[9]);
+                    g(s, 1, 6, 11, 12, m[10], m[11]);
+                    g(s, 2, 7, 8, 13, m[12], m[13]);
+                    g(s, 3, 4, 9, 14, m[14], m[15]);
+                    if (r < 6) {
+                        Words16 permuted;
+                        for (std::size_t i = 0; i < 16; ++i) {
+                            permuted[i] = m[msgPermutation[i]];
+                        }
+                        m = permuted;
+                    }
+                }
+                Words8 out;
+                for (std::size_t i = 0; i < 8; ++i) {
+                    out[i] = s[i] ^ s[i + 8];
+                }
+                return out;
+            }
+
+            inline Words16 blockToWords(const unsigned char *block) noexcept {
+                Words16 words;
+                for (std::size_t i = 0; i < 16; ++i) {
+                    words[i] = readLE32(block + i * 4);
+                }
+                return words;
+            }
+
+            /**
+             * @brief Inputs of a pending compression, either a chunk's last block or a parent node.
+             */
+            struct Output {
+                Words8 inputCv;
+                Words16 blockWords;
+                std::uint64_t counter;
+                std::uint32_t blockLen;
+                std::uint32_t flags;
+
+                Words8 chainingValue() const noexcept {
+                    return compress(inputCv, blockWords, counter, blockLen, flags);
+                }
+
+                Words8 rootValue() const noexcept {
+                    return compress(inputCv, blockWords, 0, blockLen, flags | root);
+                }
+            };
+
+            inline Output parentOutput(const Words8 &left, const Words8 &right) noexcept {
+                Output out;
+                out.inputCv = iv;
+                std::copy(left.begin(), left.end(), out.blockWords.begin());
+                std::copy(right.begin(), right.end(), out.blockWords.begin() + 8);
+                out.counter = 0;
+                out.blockLen = static_cast<std::uint32_t>(blockLen);
+                out.flags = parent;
+                return out;
+            }
+        } // namespace blake3
+
+        /**
+         * @brief Streaming BLAKE3 state (unkeyed hash mode, 32-byte output, portable implementation).
+         */
+        class Blake3State {
+        public:
+            Blake3State() noexcept {
+                reset();
+            }
+
+            void reset() noexcept {
+                chunkCv = blake3::iv;
+                chunkCounter = 0;
+                blockLen = 0;
+                blocksCompressed = 0;
+                stackSize = 0;
+            }
+
+            void update(const unsigned char *input, std::size_t len) noexcept {
+                while (len > 0) {
+                    if (chunkBytes() == blake3::chunkLen) {
+                        blake3::Words8 cv = chunkOutput().chainingValue();
+                        std::uint64_t totalChunks = chunkCounter + 1;
+                        addChunkCv(cv, totalChunks);
+                        chunkCv = blake3::iv;
+                        chunkCounter = totalChunks;
+                        blockLen = 0;
+                        blocksCompressed = 0;
+                    }
+                    std::size_t want = blake3::chunkLen - chunkBytes();
+                    std::size_t take = std::min(want, len);
+                    // Feed the chunk block by block, compressing a full block only once more input arrives
+                    std::size_t remaining = take;
+                    while (remaining > 0) {
+                        if (blockLen == blake3::blockLen) {
+                            chunkCv = blake3::compress(chunkCv, blake3::blockToWords(block.data()), chunkCounter,
+                                                       static_cast<std::uint32_t>(blake3::blockLen), startFlag());
+                            ++blocksCompressed;
+                            blockLen = 0;
+                        }
+                        std::size_t n = std::min(blake3::blockLen - blockLen, remaining);
+                        std::memcpy(block.data() + blockLen, input, n);
+                        blockLen += n;
+                        input += n;
+                        remaining -= n;
+                    }
+                    len -= take;
+                }
+            }
+
+            std::array<unsigned char, blake3::outLen> digest() const noexcept {
+                blake3::Output output = chunkOutput();
+                for (std::size_t i = stackSize; i > 0; --i) {
+                    output = blake3::parentOutput(cvStack[i - 1], output.chainingValue());
+                }
+                blake3::Words8 words = output.rootValue();
+                std::array<unsigned char, blake3::outLen> out{};
+                for (std::size_t i = 0; i < 8; ++i) {
+                    out[i * 4] = static_cast<unsigned char>(words[i]);
+                    out[i * 4 + 1] = static_cast<unsigned char>(words[i] >> 8);
+                    out[i * 4 + 2] = static_cast<unsigned char>(words[i] >> 16);
+                    out[i * 4 + 3] = static_cast<unsigned char>(words[i] >> 24);
+                }
+                return out;
+            }
+
+        private:
+            std::size_t chunkBytes() const noexcept {
+                return blocksCompressed * blake3::blockLen + blockLen;
+            }
+
+            std::uint32_t startFlag() const noexcept {
+                return blocksCompressed == 0 ? blake3::chunkStart : 0;
+            }
+
+            blake3::Output chunkOutput() const noexcept {
+                blake3::Output out;
+                out.inputCv = chunkCv;
+                std::array<unsigned char, blake3::blockLen> padded{};
+                std::memcpy(padded.data(), block.data(), blockLen);
+                out.blockWords = blake3::blockToWords(padded.data());
+                out.counter = chunkCounter;
+                out.blockLen = static_cast<std::uint32_t>(blockLen);
+                out.flags = startFlag() | blake3::chunkEnd;
+                return out;
+            }
+
+            void addChunkCv(blake3::Words8 cv, std::uint64_t totalChunks) noexcept {
+                while ((totalChunks & 1) == 0) {
+                    cv = blake3::parentOutput(cvStack[--stackSize], cv).chainingValue();
+                    totalChunks >>= 1;
+                }
+                cvStack[stackSize++] = cv;
+            }
+
+            blake3::Words8 chunkCv{};
+            std::uint64_t chunkCounter = 0;
+            std::array<unsigned char, blake3::blockLen> block{};
+            std::size_t blockLen = 0;
+            std::size_t blocksCompressed = 0;
+            std::array<blake3::Words8, blake3::maxDepth> cvStack{};
+            std::size_t stackSize = 0;
+        };
+
+    } // namespace detail
+
+    /**
+     * @brief Computes or continues a CRC-32 (zip/gzip polynomial).
+     * @param data Pointer to the data
+     * @param size Number of bytes
+     * @param crc Previous CRC value to continue from, 0 to start
+     * @return Updated CRC value, directly comparable with the CRC stored in zip entries
+     */
+    inline std::uint32_t crc32(const void *data, std::size_t size, std::uint32_t crc = 0) noexcept {
+        return ~detail::crc32Update(~crc, static_cast<const unsigned char *>(data), size);
+    }
+
+    /**
+     * @brief Computes or continues a CRC-32C (Castagnoli), hardware accelerated where supported.
+     * @param data Pointer to the data
+     * @param size Number of bytes
+     * @param crc Previous CRC value to continue from, 0 to start
+     * @return Updated CRC value
+     */
+    inline std::uint32_t crc32c(const void *data, std::size_t size, std::uint32_t crc = 0) noexcept {
+        return ~detail::crc32cUpdate(~crc, static_cast<const unsigned char *>(data), size);
+    }
+
+} // namespace neko::util::hash
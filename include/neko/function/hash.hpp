@@ -11,23 +11,37 @@
 #undef NEKO_FUNCTION_ENABLE_HASH // If no supported hash functions are available, undefine the macro
 #endif
 
-#if !defined(NEKO_FUNCTION_ENABLE_HASH)
-#error "hash.hpp requires enable hash support. Please install openSSL and set NEKO_FUNCTION_ENABLE_HASH = ON in CMake."
-#endif
-
+#include <neko/function/fastHash.hpp>
+#include <neko/function/mappedFile.hpp>
+#include <neko/function/profile.hpp>
+#include <neko/function/threadPool.hpp>
 #include <neko/schema/exception.hpp>
 
-#include <fstream>
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <istream>
+#include <span>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #endif // NEKO_FUNCTION_ENABLE_MODULE
 
 /**
  * @namespace neko::util::hash
  * @brief Hash computation utilities.
+ *
+ * md5 / sha1 / sha256 / sha512 are computed with OpenSSL and require NEKO_IMPORT_OPENSSL.
+ * crc32 / crc32c / xxh3_64 / xxh3_128 / blake3 are built in and always available.
  */
 namespace neko::util::hash {
     /**
@@ -35,112 +49,806 @@ namespace neko::util::hash {
      * @brief Supported hash algorithms.
      */
     enum class Algorithm {
-        none,   ///< No algorithm
-        md5,    ///< MD5 algorithm
-        sha1,   ///< SHA-1 algorithm
-        sha256, ///< SHA-256 algorithm
-        sha512  ///< SHA-512 algorithm
+        none,     ///< No algorithm
+        md5,      ///< MD5 algorithm
+        sha1,     ///< SHA-1 algorithm
+        sha256,   ///< SHA-256 algorithm
+        sha512,   ///< SHA-512 algorithm
+        crc32,    ///< CRC-32 (zip/gzip polynomial), non-cryptographic
+        crc32c,   ///< CRC-32C (Castagnoli), hardware accelerated where supported, non-cryptographic
+        xxh3_64,  ///< XXH3 64-bit, non-cryptographic
+        xxh3_128, ///< XXH3 128-bit, non-cryptographic
+        blake3    ///< BLAKE3 256-bit (portable implementation)
     };
 
+    /**
+     * @brief Compile-time table of hash algorithms and their string representations.
+     */
+    inline constexpr std::array<std::pair<Algorithm, std::string_view>, 9> algorithmNames = {{
+        {Algorithm::md5, "md5"},
+        {Algorithm::sha1, "sha1"},
+        {Algorithm::sha256, "sha256"},
+        {Algorithm::sha512, "sha512"},
+        {Algorithm::crc32, "crc32"},
+        {Algorithm::crc32c, "crc32c"},
+        {Algorithm::xxh3_64, "xxh3"},
+        {Algorithm::xxh3_128, "xxh128"},
+        {Algorithm::blake3, "blake3"}}};
+
     /**
      * @brief Mapping between hash algorithms and their string representations.
+     * @note Kept for compatibility, mapAlgorithm uses the constexpr algorithmNames table.
      */
     inline std::unordered_map<Algorithm, std::string> hashAlgorithmMap = {
         {Algorithm::md5, "md5"},
         {Algorithm::sha1, "sha1"},
         {Algorithm::sha256, "sha256"},
-        {Algorithm::sha512, "sha512"}};
+        {Algorithm::sha512, "sha512"},
+        {Algorithm::crc32, "crc32"},
+        {Algorithm::crc32c, "crc32c"},
+        {Algorithm::xxh3_64, "xxh3"},
+        {Algorithm::xxh3_128, "xxh128"},
+        {Algorithm::blake3, "blake3"}};
 
     /**
      * @brief Maps a string to a hash algorithm.
      * @param str String representation of a hash algorithm
-     * @return Corresponding hash algorithm enum value
+     * @return Corresponding hash algorithm enum value, Algorithm::none if not found
      */
-    inline auto mapAlgorithm(const std::string &str) {
-        for (auto it : hashAlgorithmMap) {
-            if (it.second == str) {
-                return it.first;
+    constexpr Algorithm mapAlgorithm(std::string_view str) noexcept {
+        for (const auto &[algorithm, name] : algorithmNames) {
+            if (name == str) {
+                return algorithm;
             }
         }
         return Algorithm::none;
     }
 
     /**
-     * @brief Maps a hash algorithm to its string representation.
+     * @brief Gets the string representation of a hash algorithm without allocating.
      * @param algorithm Hash algorithm enum value
-     * @return String representation of the hash algorithm
+     * @return String representation of the hash algorithm, "unknown" if not found
      */
-    inline auto mapAlgorithm(Algorithm algorithm) {
-        for (auto it : hashAlgorithmMap) {
-            if (it.first == algorithm) {
-                return it.second;
+    constexpr std::string_view algorithmName(Algorithm algorithm) noexcept {
+        for (const auto &[alg, name] : algorithmNames) {
+            if (alg == algorithm) {
+                return name;
             }
         }
-        return std::string("unknown");
+        return "unknown";
     }
 
     /**
-     * @brief Computes the hash of a string.
-     * @param str String to hash
-     * @param algorithm Hash algorithm to use
-     * @return Hexadecimal string representation of the hash
+     * @brief Maps a hash algorithm to its string representation.
+     * @param algorithm Hash algorithm enum value
+     * @return String representation of the hash algorithm
+     */
+    inline std::string mapAlgorithm(Algorithm algorithm) {
+        return std::string(algorithmName(algorithm));
+    }
+
+    /**
+     * @brief Default chunk size used when hashing streams and files.
+     */
+    constexpr std::size_t defaultChunkSize = 64 * 1024;
+
+    /**
+     * @brief Checks whether an algorithm is one of the OpenSSL backed cryptographic digests.
+     * @param algorithm Hash algorithm enum value
+     * @return true for md5, sha1, sha256 and sha512
+     */
+    constexpr bool isOpenSslAlgorithm(Algorithm algorithm) noexcept {
+        return algorithm == Algorithm::md5 || algorithm == Algorithm::sha1 ||
+               algorithm == Algorithm::sha256 || algorithm == Algorithm::sha512;
+    }
+
+    /**
+     * @brief Checks whether an algorithm is one of the built-in, dependency-free algorithms.
+     * @param algorithm Hash algorithm enum value
+     * @return true for crc32, crc32c, xxh3_64, xxh3_128 and blake3
      */
-    inline std::string digest(const std::string str, Algorithm algorithm = Algorithm::sha256) {
-        // Hash computation using OpenSSL
+    constexpr bool isBuiltinAlgorithm(Algorithm algorithm) noexcept {
+        return algorithm == Algorithm::crc32 || algorithm == Algorithm::crc32c ||
+               algorithm == Algorithm::xxh3_64 || algorithm == Algorithm::xxh3_128 ||
+               algorithm == Algorithm::blake3;
+    }
+
+    namespace detail {
 #if defined(NEKO_IMPORT_OPENSSL)
-        const unsigned char *unsignedData = reinterpret_cast<const unsigned char *>(str.c_str());
-        unsigned char outBuf[EVP_MAX_MD_SIZE];
-        unsigned int condLen = 0;
+        /**
+         * @brief Maps a hash algorithm to its OpenSSL message digest.
+         * On OpenSSL 3 the digests are fetched explicitly once and cached for the process lifetime,
+         * which avoids the implicit provider fetch on every EVP_DigestInit_ex call.
+         * @param algorithm Hash algorithm enum value
+         * @return OpenSSL digest, or nullptr if the algorithm is not supported
+         */
+        inline const EVP_MD *evpMd(Algorithm algorithm) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+            struct FetchedDigests {
+                EVP_MD *md5 = EVP_MD_fetch(nullptr, "MD5", nullptr);
+                EVP_MD *sha1 = EVP_MD_fetch(nullptr, "SHA1", nullptr);
+                EVP_MD *sha256 = EVP_MD_fetch(nullptr, "SHA256", nullptr);
+                EVP_MD *sha512 = EVP_MD_fetch(nullptr, "SHA512", nullptr);
+                ~FetchedDigests() {
+                    EVP_MD_free(md5);
+                    EVP_MD_free(sha1);
+                    EVP_MD_free(sha256);
+                    EVP_MD_free(sha512);
+                }
+            };
+            static const FetchedDigests fetched;
+            switch (algorithm) {
+                case Algorithm::sha1:
+                    return fetched.sha1;
+                case Algorithm::sha256:
+                    return fetched.sha256;
+                case Algorithm::sha512:
+                    return fetched.sha512;
+                case Algorithm::md5:
+                    return fetched.md5;
+                default:
+                    return nullptr;
+            }
+#else
+            switch (algorithm) {
+                case Algorithm::sha1:
+                    return EVP_sha1();
+                case Algorithm::sha256:
+                    return EVP_sha256();
+                case Algorithm::sha512:
+                    return EVP_sha512();
+                case Algorithm::md5:
+                    return EVP_md5();
+                default:
+                    return nullptr;
+            }
+#endif // OPENSSL_VERSION_NUMBER
+        }
+
+        /**
+         * @brief Maximum number of idle hash contexts kept per thread.
+         */
+        constexpr std::size_t maxPooledContexts = 8;
+
+        /**
+         * @brief Set once the calling thread's context pool has been destroyed.
+         * Trivially destructible, so it stays valid while other thread_local objects are torn down.
+         */
+        inline thread_local bool contextPoolDestroyed = false;
+
+        /**
+         * @brief Per-thread pool of idle EVP_MD_CTX objects.
+         */
+        struct ContextPool {
+            std::vector<EVP_MD_CTX *> idle;
+
+            ~ContextPool() {
+                for (auto *ctx : idle) {
+                    EVP_MD_CTX_free(ctx);
+                }
+                contextPoolDestroyed = true;
+            }
+
+            static ContextPool &local() {
+                thread_local ContextPool pool;
+                return pool;
+            }
+        };
+
+        /**
+         * @brief Takes a hash context from the calling thread's pool, or creates a new one.
+         * @return Hash context, nullptr if allocation fails
+         */
+        inline EVP_MD_CTX *acquireContext() {
+            if (!contextPoolDestroyed) {
+                auto &pool = ContextPool::local();
+                if (!pool.idle.empty()) {
+                    EVP_MD_CTX *ctx = pool.idle.back();
+                    pool.idle.pop_back();
+                    return ctx;
+                }
+            }
+            return EVP_MD_CTX_new();
+        }
+
+        /**
+         * @brief Resets a hash context and returns it to the calling thread's pool.
+         * @param ctx Hash context, freed instead if the pool is full or already destroyed
+         */
+        inline void releaseContext(EVP_MD_CTX *ctx) noexcept {
+            if (ctx == nullptr) {
+                return;
+            }
+            if (!contextPoolDestroyed) {
+                auto &pool = ContextPool::local();
+                if (pool.idle.size() < maxPooledContexts && EVP_MD_CTX_reset(ctx) == 1) {
+                    try {
+                        pool.idle.push_back(ctx);
+                        return;
+                    } catch (...) {
+                        // fall through and free
+                    }
+                }
+            }
+            EVP_MD_CTX_free(ctx);
+        }
+#endif // NEKO_IMPORT_OPENSSL
+
+        /**
+         * @brief Running state of a built-in algorithm; CRC variants keep the current CRC value.
+         */
+        using BuiltinState = std::variant<std::monostate, std::uint32_t, Xxh3State, Blake3State>;
 
-        const EVP_MD *md = nullptr;
+        /**
+         * @brief Lookup table mapping every byte value to its two lowercase hexadecimal characters.
+         */
+        inline constexpr auto hexTable = [] {
+            constexpr char digits[] = "0123456789abcdef";
+            std::array<char, 512> table{};
+            for (std::size_t i = 0; i < 256; ++i) {
+                table[i * 2] = digits[i >> 4];
+                table[i * 2 + 1] = digits[i & 0x0F];
+            }
+            return table;
+        }();
+    } // namespace detail
+
+    /**
+     * @brief Maximum digest size in bytes of any supported algorithm.
+     */
+    constexpr std::size_t maxDigestSize = 64;
+
+    /**
+     * @brief Gets the digest size in bytes of a hash algorithm.
+     * @param algorithm Hash algorithm enum value
+     * @return Digest size in bytes, 0 for unsupported algorithms
+     */
+    constexpr std::size_t digestSize(Algorithm algorithm) noexcept {
         switch (algorithm) {
+            case Algorithm::md5:
+                return 16;
             case Algorithm::sha1:
-                md = EVP_sha1();
-                break;
+                return 20;
             case Algorithm::sha256:
-                md = EVP_sha256();
-                break;
+                return 32;
             case Algorithm::sha512:
-                md = EVP_sha512();
-                break;
-            case Algorithm::md5:
-                md = EVP_md5();
-                break;
+                return 64;
+            case Algorithm::crc32:
+            case Algorithm::crc32c:
+                return 4;
+            case Algorithm::xxh3_64:
+                return 8;
+            case Algorithm::xxh3_128:
+                return 16;
+            case Algorithm::blake3:
+                return 32;
             default:
-                break;
+                return 0;
+        }
+    }
+
+    /**
+     * @brief Checks whether an algorithm can be computed in this build.
+     * @param algorithm Hash algorithm enum value
+     * @return true for the built-in algorithms, and for the OpenSSL digests when OpenSSL is available
+     */
+    inline bool isSupported(Algorithm algorithm) {
+        if (isBuiltinAlgorithm(algorithm)) {
+            return true;
+        }
+#if defined(NEKO_IMPORT_OPENSSL)
+        return detail::evpMd(algorithm) != nullptr;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Writes the lowercase hexadecimal representation of bytes into a caller-provided buffer.
+     * @param bytes Bytes to encode
+     * @param out Output buffer, must hold at least bytes.size() * 2 characters (no null terminator is written)
+     * @return Pointer one past the last character written
+     */
+    constexpr char *toHex(std::span<const std::uint8_t> bytes, char *out) noexcept {
+        for (auto b : bytes) {
+            *out++ = detail::hexTable[b * 2];
+            *out++ = detail::hexTable[b * 2 + 1];
+        }
+        return out;
+    }
+
+    /**
+     * @brief Encodes bytes as a lowercase hexadecimal string.
+     * @param bytes Bytes to encode
+     * @return Hexadecimal string
+     */
+    inline std::string toHex(std::span<const std::uint8_t> bytes) {
+        std::string result(bytes.size() * 2, '\0');
+        toHex(bytes, result.data());
+        return result;
+    }
+
+    /**
+     * @struct Digest
+     * @brief Binary digest value with a fixed-size inline buffer (no heap allocation).
+     */
+    struct Digest {
+        std::array<std::uint8_t, maxDigestSize> bytes{};
+        std::size_t length = 0;
+
+        constexpr const std::uint8_t *data() const noexcept { return bytes.data(); }
+        constexpr std::size_t size() const noexcept { return length; }
+        constexpr bool empty() const noexcept { return length == 0; }
+        constexpr const std::uint8_t *begin() const noexcept { return bytes.data(); }
+        constexpr const std::uint8_t *end() const noexcept { return bytes.data() + length; }
+        constexpr std::span<const std::uint8_t> view() const noexcept { return {bytes.data(), length}; }
+
+        /**
+         * @brief Gets the hexadecimal string representation of the digest.
+         */
+        std::string hex() const {
+            return toHex(view());
+        }
+
+        constexpr bool operator==(const Digest &other) const noexcept {
+            return length == other.length && std::equal(begin(), end(), other.begin());
+        }
+    };
+
+    /**
+     * @class Hasher
+     * @brief Incremental hash computation.
+     *
+     * Data can be fed in any number of chunks via update(), which allows hashing
+     * files, streams and network downloads without holding the whole input in memory.
+     *
+     * @example
+     * Hasher hasher(Algorithm::sha256);
+     * hasher.update("hello ").update("world");
+     * std::string hex = hasher.finalize();
+     *
+     * Digests of the built-in checksums are in canonical big-endian byte order,
+     * so crc32 / xxh3 hex strings match the output of common tools (e.g. crc32, xxhsum).
+     *
+     * @note After finalize() the hasher must be re-initialized with init() before reuse.
+     * @throws ex::InvalidArgument if the algorithm is not supported
+     * @throws ex::NotImplemented if a cryptographic algorithm is requested without OpenSSL support
+     * @throws ex::Runtime if the underlying hash context fails
+     */
+    class Hasher {
+    public:
+        explicit Hasher(Algorithm algorithm = Algorithm::sha256) : algorithm(algorithm) {
+            init();
+        }
+
+        ~Hasher() {
+#if defined(NEKO_IMPORT_OPENSSL)
+            detail::releaseContext(ctx);
+#endif
+        }
+
+        Hasher(const Hasher &) = delete;
+        Hasher &operator=(const Hasher &) = delete;
+
+        Hasher(Hasher &&other) noexcept
+            : algorithm(other.algorithm), builtin(std::move(other.builtin))
+#if defined(NEKO_IMPORT_OPENSSL)
+              ,
+              ctx(std::exchange(other.ctx, nullptr))
+#endif
+        {
         }
 
-        if (md != nullptr) {
-            EVP_MD_CTX *ctx = EVP_MD_CTX_new();
-            if (ctx != nullptr) {
-                EVP_DigestInit_ex(ctx, md, nullptr);
-                EVP_DigestUpdate(ctx, unsignedData, str.size());
-                EVP_DigestFinal_ex(ctx, outBuf, &condLen);
-                EVP_MD_CTX_free(ctx);
+        Hasher &operator=(Hasher &&other) noexcept {
+            if (this != &other) {
+                algorithm = other.algorithm;
+                builtin = std::move(other.builtin);
+#if defined(NEKO_IMPORT_OPENSSL)
+                detail::releaseContext(ctx);
+                ctx = std::exchange(other.ctx, nullptr);
+#endif
+            }
+            return *this;
+        }
+
+        /**
+         * @brief (Re)initializes the hasher, discarding any data fed so far.
+         */
+        void init() {
+            switch (algorithm) {
+                case Algorithm::crc32:
+                case Algorithm::crc32c:
+                    builtin.emplace<std::uint32_t>(0);
+                    return;
+                case Algorithm::xxh3_64:
+                case Algorithm::xxh3_128:
+                    builtin.emplace<detail::Xxh3State>();
+                    return;
+                case Algorithm::blake3:
+                    builtin.emplace<detail::Blake3State>();
+                    return;
+                default:
+                    break;
+            }
+#if defined(NEKO_IMPORT_OPENSSL)
+            const EVP_MD *md = detail::evpMd(algorithm);
+            if (md == nullptr) {
+                throw ex::InvalidArgument("Unsupported hash algorithm: " + mapAlgorithm(algorithm));
+            }
+            if (ctx == nullptr) {
+                ctx = detail::acquireContext();
+                if (ctx == nullptr) {
+                    throw ex::Runtime("Failed to create hash context");
+                }
+            }
+            if (EVP_DigestInit_ex(ctx, md, nullptr) != 1) {
+                throw ex::Runtime("Failed to initialize hash context");
+            }
+#else
+            if (!isOpenSslAlgorithm(algorithm)) {
+                throw ex::InvalidArgument("Unsupported hash algorithm: " + mapAlgorithm(algorithm));
+            }
+            throw ex::NotImplemented("Hash function " + mapAlgorithm(algorithm) + " is not supported. Please enable OpenSSL support.");
+#endif // NEKO_IMPORT_OPENSSL
+        }
+
+        /**
+         * @brief Feeds raw bytes into the hasher.
+         * @param data Pointer to the data
+         * @param size Number of bytes
+         * @return Reference to this hasher for chaining
+         */
+        Hasher &update(const void *data, std::size_t size) {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            switch (algorithm) {
+                case Algorithm::crc32:
+                    std::get<std::uint32_t>(builtin) = crc32(bytes, size, std::get<std::uint32_t>(builtin));
+                    return *this;
+                case Algorithm::crc32c:
+                    std::get<std::uint32_t>(builtin) = crc32c(bytes, size, std::get<std::uint32_t>(builtin));
+                    return *this;
+                case Algorithm::xxh3_64:
+                case Algorithm::xxh3_128:
+                    std::get<detail::Xxh3State>(builtin).update(bytes, size);
+                    return *this;
+                case Algorithm::blake3:
+                    std::get<detail::Blake3State>(builtin).update(bytes, size);
+                    return *this;
+                default:
+                    break;
+            }
+#if defined(NEKO_IMPORT_OPENSSL)
+            if (size > 0 && EVP_DigestUpdate(ctx, bytes, size) != 1) {
+                throw ex::Runtime("Failed to update hash context");
             }
+#endif
+            return *this;
+        }
+
+        /**
+         * @brief Feeds a byte span into the hasher.
+         */
+        Hasher &update(std::span<const std::byte> data) {
+            return update(data.data(), data.size());
         }
 
-        std::stringstream ssRes;
-        for (unsigned int i = 0; i < condLen; ++i) {
-            ssRes << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(outBuf[i]);
+        /**
+         * @brief Feeds a string into the hasher.
+         */
+        Hasher &update(std::string_view data) {
+            return update(data.data(), data.size());
         }
-        return ssRes.str();
+
+        /**
+         * @brief Feeds the remaining content of a stream into the hasher, reading in fixed-size chunks.
+         * @param stream Input stream, should be opened in binary mode
+         * @param chunkSize Size of the read buffer in bytes
+         * @return Reference to this hasher for chaining
+         * @throws ex::FileError if reading from the stream fails
+         */
+        Hasher &update(std::istream &stream, std::size_t chunkSize = defaultChunkSize) {
+            NEKO_FUNCTION_PROFILE_SCOPE(timer, "hash.Hasher.updateStream");
+            std::string buffer(chunkSize, '\0');
+            while (stream) {
+                stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                auto got = stream.gcount();
+                if (got > 0) {
+                    update(buffer.data(), static_cast<std::size_t>(got));
+                    NEKO_FUNCTION_PROFILE_BYTES(timer, got);
+                }
+            }
+            if (stream.bad()) {
+                throw ex::FileError("Failed to read stream while hashing");
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Finishes the computation.
+         * @return Binary digest
+         */
+        Digest finalizeRaw() {
+            if (isBuiltinAlgorithm(algorithm)) {
+                return finalizeBuiltin();
+            }
+#if defined(NEKO_IMPORT_OPENSSL)
+            static_assert(EVP_MAX_MD_SIZE >= maxDigestSize, "Digest buffer larger than EVP_MAX_MD_SIZE");
+            unsigned char outBuf[EVP_MAX_MD_SIZE];
+            unsigned int outLen = 0;
+            if (EVP_DigestFinal_ex(ctx, outBuf, &outLen) != 1) {
+                throw ex::Runtime("Failed to finalize hash context");
+            }
+            Digest result;
+            result.length = std::min<std::size_t>(outLen, maxDigestSize);
+            std::copy_n(outBuf, result.length, result.bytes.begin());
+            return result;
 #else
-#pragma message("hash.hpp: hash support is not enabled. Please install OpenSSL and set NEKO_FUNCTION_ENABLE_HASH = ON in CMake.")
-        throw ex::NotImplemented("Hash functions are not supported. Please enable OpenSSL support.");
+            throw ex::NotImplemented("Hash functions are not supported. Please enable OpenSSL support.");
 #endif // NEKO_IMPORT_OPENSSL
+        }
+
+        /**
+         * @brief Finishes the computation.
+         * @return Hexadecimal string representation of the hash
+         */
+        std::string finalize() {
+            return finalizeRaw().hex();
+        }
+
+        /**
+         * @brief Gets the algorithm used by this hasher.
+         */
+        Algorithm getAlgorithm() const noexcept {
+            return algorithm;
+        }
+
+    private:
+        Digest finalizeBuiltin() const {
+            Digest result;
+            result.length = digestSize(algorithm);
+            switch (algorithm) {
+                case Algorithm::crc32:
+                case Algorithm::crc32c:
+                    detail::writeBE32(result.bytes.data(), std::get<std::uint32_t>(builtin));
+                    break;
+                case Algorithm::xxh3_64:
+                    detail::writeBE64(result.bytes.data(), std::get<detail::Xxh3State>(builtin).digest64());
+                    break;
+                case Algorithm::xxh3_128: {
+                    auto h128 = std::get<detail::Xxh3State>(builtin).digest128();
+                    detail::writeBE64(result.bytes.data(), h128.high64);
+                    detail::writeBE64(result.bytes.data() + 8, h128.low64);
+                    break;
+                }
+                case Algorithm::blake3: {
+                    auto out = std::get<detail::Blake3State>(builtin).digest();
+                    std::copy(out.begin(), out.end(), result.bytes.begin());
+                    break;
+                }
+                default:
+                    result.length = 0;
+                    break;
+            }
+            return result;
+        }
+
+        Algorithm algorithm;
+        detail::BuiltinState builtin;
+#if defined(NEKO_IMPORT_OPENSSL)
+        EVP_MD_CTX *ctx = nullptr;
+#endif
+    };
+
+    /**
+     * @brief Computes the binary hash of a buffer.
+     * @param data Data to hash
+     * @param algorithm Hash algorithm to use
+     * @return Binary digest, empty if the algorithm is not supported
+     * @throws ex::NotImplemented if a cryptographic algorithm is requested without OpenSSL support
+     */
+    inline Digest digestRaw(std::string_view data, Algorithm algorithm = Algorithm::sha256) {
+        NEKO_FUNCTION_PROFILE_SCOPE(timer, "hash.digest");
+        NEKO_FUNCTION_PROFILE_BYTES(timer, data.size());
+        if (!isSupported(algorithm)) {
+#if !defined(NEKO_IMPORT_OPENSSL)
+#pragma message("hash.hpp: OpenSSL is not enabled, only the built-in hash algorithms are available. Install OpenSSL and set NEKO_FUNCTION_ENABLE_HASH = ON in CMake for md5/sha.")
+            if (isOpenSslAlgorithm(algorithm)) {
+                throw ex::NotImplemented("Hash function " + mapAlgorithm(algorithm) + " is not supported. Please enable OpenSSL support.");
+            }
+#endif // NEKO_IMPORT_OPENSSL
+            return {};
+        }
+        Hasher hasher(algorithm);
+        hasher.update(data);
+        return hasher.finalizeRaw();
+    }
+
+    /**
+     * @brief Computes the hash of a string.
+     * @param str String to hash
+     * @param algorithm Hash algorithm to use
+     * @return Hexadecimal string representation of the hash, or an empty string if the algorithm is not supported
+     */
+    inline std::string digest(const std::string &str, Algorithm algorithm = Algorithm::sha256) {
+        return digestRaw(str, algorithm).hex();
+    }
+
+    /**
+     * @brief Computes the hash of the remaining content of a stream.
+     * @param stream Input stream, should be opened in binary mode
+     * @param algorithm Hash algorithm to use
+     * @param chunkSize Size of the read buffer in bytes
+     * @return Hexadecimal string representation of the hash, or an empty string if the algorithm is not supported
+     * @throws ex::FileError if reading from the stream fails
+     * @throws ex::NotImplemented if a cryptographic algorithm is requested without OpenSSL support
+     */
+    inline std::string digest(std::istream &stream, Algorithm algorithm = Algorithm::sha256, std::size_t chunkSize = defaultChunkSize) {
+        if (!isSupported(algorithm) && !isOpenSslAlgorithm(algorithm)) {
+            return {};
+        }
+        Hasher hasher(algorithm);
+        hasher.update(stream, chunkSize);
+        return hasher.finalize();
+    }
+
+    namespace detail {
+        // Feeds the whole file to hasher and returns the bytes consumed, which for a stream is only known afterwards
+        inline std::uint64_t hashFile(Hasher &hasher, fs::MappedFile &file, std::size_t chunkSize) {
+            if (file.isContiguous()) {
+                hasher.update(file.bytes());
+                return file.bytes().size();
+            }
+            return file.forEachChunk(chunkSize, [&](std::span<const std::byte> chunk) { hasher.update(chunk); });
+        }
+    } // namespace detail
+
+    /**
+     * @brief Computes the hash of an opened file, reading the mapped pages in place.
+     * A contiguous file is hashed in one update; a stream is read in chunkSize pieces.
+     * @param file Opened file; a stream is consumed
+     * @param algorithm Hash algorithm to use
+     * @param chunkSize Size of the read buffer in bytes, used only for streams
+     * @return Hexadecimal string representation of the hash, or an empty string if the algorithm is not supported
+     * @throws ex::FileError if reading from a stream fails
+     */
+    inline std::string digest(fs::MappedFile &file, Algorithm algorithm = Algorithm::sha256, std::size_t chunkSize = defaultChunkSize) {
+        if (!isSupported(algorithm) && !isOpenSslAlgorithm(algorithm)) {
+            return {};
+        }
+        Hasher hasher(algorithm);
+        detail::hashFile(hasher, file, chunkSize);
+        return hasher.finalize();
     }
 
     /**
      * @brief Computes the hash of a file.
+     * Local files are memory-mapped and hashed in place; pipes and network files are read in fixed-size chunks,
+     * so memory usage does not depend on the file size.
      * @param name Path to the file
      * @param algorithm Hash algorithm to use
+     * @param chunkSize Size of the read buffer in bytes
      * @return Hexadecimal string representation of the hash
+     * @throws ex::FileError if the file cannot be opened or read
      */
-    inline std::string digestFile(const std::string &name, Algorithm algorithm = Algorithm::sha256) {
-        std::ifstream file(name, std::ios::binary);
-        std::string raw((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-        return digest(raw, algorithm);
+    inline std::string digestFile(const std::string &name, Algorithm algorithm = Algorithm::sha256, std::size_t chunkSize = defaultChunkSize) {
+        NEKO_FUNCTION_PROFILE_SCOPE(timer, "hash.digestFile");
+        fs::MappedFile file(name, fs::AccessHint::sequential);
+        if (!isSupported(algorithm) && !isOpenSslAlgorithm(algorithm)) {
+            return {};
+        }
+        Hasher hasher(algorithm);
+        [[maybe_unused]] const auto bytes = detail::hashFile(hasher, file, chunkSize);
+        NEKO_FUNCTION_PROFILE_BYTES(timer, bytes);
+        return hasher.finalize();
+    }
+
+    /**
+     * @brief Computes the hash of a file on the shared thread pool.
+     * @param name Path to the file
+     * @param algorithm Hash algorithm to use
+     * @param chunkSize Size of the read buffer in bytes
+     * @return A future holding the hexadecimal digest, or the ex::FileError thrown by digestFile
+     */
+    inline std::future<std::string> digestFileAsync(std::string name, Algorithm algorithm = Algorithm::sha256, std::size_t chunkSize = defaultChunkSize) {
+        return pool::defaultPool().submit([name = std::move(name), algorithm, chunkSize] {
+            return digestFile(name, algorithm, chunkSize);
+        });
+    }
+
+    /**
+     * @brief Computes several hashes of a file in a single read pass.
+     * @param name Path to the file
+     * @param algorithms Hash algorithms to compute
+     * @param chunkSize Size of the read buffer in bytes
+     * @return Hexadecimal digests in the same order as algorithms (empty string for unsupported algorithms)
+     * @throws ex::FileError if the file cannot be opened or read
+     */
+    inline std::vector<std::string> digestFile(const std::string &name, const std::vector<Algorithm> &algorithms, std::size_t chunkSize = defaultChunkSize) {
+        NEKO_FUNCTION_PROFILE_SCOPE(timer, "hash.digestFile");
+        fs::MappedFile file(name, fs::AccessHint::sequential);
+
+        std::vector<Hasher> hashers;
+        hashers.reserve(algorithms.size());
+        for (auto algorithm : algorithms) {
+            if (!isSupported(algorithm) && !isOpenSslAlgorithm(algorithm)) {
+                continue;
+            }
+            hashers.emplace_back(algorithm);
+        }
+
+        // Chunk by chunk, so every hasher reads a piece while it is still in cache
+        [[maybe_unused]] const auto bytes = file.forEachChunk(chunkSize, [&](std::span<const std::byte> chunk) {
+            for (auto &hasher : hashers) {
+                hasher.update(chunk);
+            }
+        });
+        NEKO_FUNCTION_PROFILE_BYTES(timer, bytes);
+
+        std::vector<std::string> result;
+        result.reserve(algorithms.size());
+        auto hasherIt = hashers.begin();
+        for (auto algorithm : algorithms) {
+            if (hasherIt != hashers.end() && hasherIt->getAlgorithm() == algorithm) {
+                result.push_back(hasherIt->finalize());
+                ++hasherIt;
+            } else {
+                result.emplace_back();
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes several hashes for each of a batch of files using a pool of worker threads.
+     * Each file is read once, all requested algorithms are computed in the same pass.
+     * @param paths Paths to the files
+     * @param algorithms Hash algorithms to compute for every file
+     * @param threads Number of worker threads, 0 uses the hardware concurrency
+     * @return One entry per path, in input order; each entry holds the digests in the same order as algorithms
+     * @throws ex::FileError if any file cannot be opened or read (the first error is rethrown after all workers stop)
+     */
+    inline std::vector<std::vector<std::string>> digestFiles(
+        const std::vector<std::string> &paths,
+        const std::vector<Algorithm> &algorithms = {Algorithm::sha256},
+        std::size_t threads = 0) {
+        std::vector<std::vector<std::string>> results(paths.size());
+        if (paths.empty()) {
+            return results;
+        }
+
+        if (threads == 0) {
+            threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+        threads = std::min(threads, paths.size());
+
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr firstError;
+        std::atomic_flag errorSet = ATOMIC_FLAG_INIT;
+
+        auto worker = [&]() {
+            while (!failed.load(std::memory_order_relaxed)) {
+                std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= paths.size()) {
+                    break;
+                }
+                try {
+                    results[i] = digestFile(paths[i], algorithms);
+                } catch (...) {
+                    if (!errorSet.test_and_set()) {
+                        firstError = std::current_exception();
+                    }
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        pool::runWorkers(threads, [&](std::size_t) { worker(); });
+
+        if (firstError) {
+            std::rethrow_exception(firstError);
+        }
+        return results;
     }
 
 } // namespace neko::util::hash
\ No newline at end of file
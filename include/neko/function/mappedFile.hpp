@@ -0,0 +1,428 @@
+/**
+ * @file mappedFile.hpp
+ * @brief Read-only memory-mapped file with a buffered fallback
+ * @author moehoshio
+ * @copyright Copyright (c) 2025 Hoshi
+ * @license MIT OR Apache-2.0
+ */
+
+#pragma once
+
+// Include header for non-module usage
+#if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
+
+#include <neko/schema/exception.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/vfs.h>
+#elif defined(__APPLE__)
+#include <sys/mount.h>
+#include <sys/param.h>
+#endif
+#endif
+
+#endif // NEKO_FUNCTION_ENABLE_MODULE
+
+namespace neko::util::fs {
+
+    /**
+     * @brief How a mapped file is going to be read, passed on to the kernel as a read-ahead hint.
+     */
+    enum class AccessHint {
+        normal,
+        sequential, // Read once from start to end, e.g. hashing
+        random      // Jumps around, e.g. an archive read through its central directory
+    };
+
+    /**
+     * @class MappedFile
+     * @brief Gives read-only access to a file's content as a byte span, without copying it into user space.
+     *
+     * Local regular files of at least mapThreshold bytes are memory-mapped; smaller ones are read once into
+     * an owned buffer, which is cheaper than setting up a mapping. Pipes, devices and files on network
+     * filesystems cannot be mapped safely and are read through a buffered stream instead, as are files
+     * reporting size 0: bytes() is empty then, and forEachChunk() reads the content once.
+     * @note The mapping reflects the file as it changes; truncating a mapped file while it is read is undefined.
+     * @code
+     * neko::util::fs::MappedFile file("assets.pak");
+     * file.forEachChunk(64 * 1024, [&](std::span<const std::byte> chunk) { hasher.update(chunk); });
+     * @endcode
+     */
+    class MappedFile {
+    public:
+        enum class Mode {
+            closed,
+            mapped,   // bytes() points into the page cache
+            buffered, // Small file, bytes() points into an owned copy
+            stream    // Not mappable, read through forEachChunk()
+        };
+
+        // Files smaller than this are read into memory rather than mapped
+        static constexpr std::size_t mapThreshold = 64 * 1024;
+
+        MappedFile() = default;
+
+        /**
+         * @throws ex::FileError if the file cannot be opened or read.
+         */
+        explicit MappedFile(std::string path, AccessHint hint = AccessHint::sequential) {
+            std::error_code ec;
+            open(std::move(path), hint, ec);
+            if (ec)
+                throw ex::FileError("Cannot open file: " + filePath);
+        }
+
+        /**
+         * @brief Opens the file, reporting failure through ec instead of throwing.
+         */
+        MappedFile(std::string path, std::error_code &ec, AccessHint hint = AccessHint::sequential) {
+            open(std::move(path), hint, ec);
+        }
+
+        ~MappedFile() {
+            close();
+        }
+
+        MappedFile(MappedFile &&other) noexcept {
+            swap(other);
+        }
+        MappedFile &operator=(MappedFile &&other) noexcept {
+            if (this != &other) {
+                close();
+                swap(other);
+            }
+            return *this;
+        }
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        Mode mode() const noexcept {
+            return fileMode;
+        }
+
+        bool isOpen() const noexcept {
+            return fileMode != Mode::closed;
+        }
+
+        /**
+         * @brief Whether bytes() holds the whole content (mapped or buffered).
+         */
+        bool isContiguous() const noexcept {
+            return fileMode == Mode::mapped || fileMode == Mode::buffered;
+        }
+
+        /**
+         * @brief The whole content when contiguous, otherwise empty.
+         */
+        std::span<const std::byte> bytes() const noexcept {
+            return {view, length};
+        }
+
+        const std::string &path() const noexcept {
+            return filePath;
+        }
+
+        /**
+         * @brief The first count bytes, fewer at the end of the file.
+         * On a stream the bytes are buffered and delivered again by forEachChunk().
+         * @throws ex::FileError if reading from a stream fails.
+         */
+        std::span<const std::byte> peek(std::size_t count) {
+            if (fileMode != Mode::stream)
+                return bytes().first(std::min(count, length));
+            while (peeked.size() < count && !streamEnd) {
+                const std::size_t before = peeked.size();
+                peeked.resize(count);
+                const std::size_t got = readStream(peeked.data() + before, count - before);
+                peeked.resize(before + got);
+            }
+            return std::span<const std::byte>(peeked).first(std::min(count, peeked.size()));
+        }
+
+        /**
+         * @brief Calls fn(std::span<const std::byte>) for consecutive pieces of the content.
+         * Contiguous files are sliced in place; streams are read into a buffer of chunkSize bytes,
+         * and can be walked only once.
+         * @return The number of bytes delivered.
+         * @throws ex::FileError if reading from a stream fails.
+         */
+        template <typename F>
+        std::uint64_t forEachChunk(std::size_t chunkSize, F &&fn) {
+            chunkSize = std::max<std::size_t>(chunkSize, 1);
+            std::uint64_t total = 0;
+            if (fileMode != Mode::stream) {
+                for (std::size_t offset = 0; offset < length; offset += chunkSize) {
+                    const std::size_t size = std::min(chunkSize, length - offset);
+                    fn(std::span<const std::byte>(view + offset, size));
+                    total += size;
+                }
+                return total;
+            }
+            if (!peeked.empty()) {
+                fn(std::span<const std::byte>(peeked));
+                total += peeked.size();
+                peeked.clear();
+            }
+            std::vector<std::byte> buffer(chunkSize);
+            while (!streamEnd) {
+                const std::size_t got = readStream(buffer.data(), buffer.size());
+                if (got > 0) {
+                    fn(std::span<const std::byte>(buffer.data(), got));
+                    total += got;
+                }
+            }
+            return total;
+        }
+
+        /**
+         * @brief Unmaps or closes the file; the object can be reopened by assigning a new one.
+         */
+        void close() noexcept {
+#if defined(_WIN32)
+            if (fileMode == Mode::mapped)
+                ::UnmapViewOfFile(view);
+            if (handle != INVALID_HANDLE_VALUE)
+                ::CloseHandle(handle);
+            handle = INVALID_HANDLE_VALUE;
+#elif defined(__unix__) || defined(__APPLE__)
+            if (fileMode == Mode::mapped)
+                ::munmap(const_cast<std::byte *>(view), length);
+            if (fd >= 0)
+                ::close(fd);
+            fd = -1;
+#endif
+            view = nullptr;
+            length = 0;
+            owned.clear();
+            peeked.clear();
+            streamEnd = false;
+            fileMode = Mode::closed;
+        }
+
+    private:
+        void swap(MappedFile &other) noexcept {
+            std::swap(filePath, other.filePath);
+            std::swap(view, other.view);
+            std::swap(length, other.length);
+            std::swap(owned, other.owned);
+            std::swap(peeked, other.peeked);
+            std::swap(streamEnd, other.streamEnd);
+            std::swap(fileMode, other.fileMode);
+#if defined(_WIN32)
+            std::swap(handle, other.handle);
+#elif defined(__unix__) || defined(__APPLE__)
+            std::swap(fd, other.fd);
+#endif
+        }
+
+        // Reads the whole of a small regular file into owned
+        template <typename Read>
+        bool readAll(std::size_t size, Read &&read) {
+            owned.resize(size);
+            std::size_t filled = 0;
+            while (filled < size) {
+                const std::ptrdiff_t got = read(owned.data() + filled, size - filled);
+                if (got < 0)
+                    return false;
+                if (got == 0)
+                    break;
+                filled += static_cast<std::size_t>(got);
+            }
+            owned.resize(filled);
+            view = owned.data();
+            length = filled;
+            fileMode = Mode::buffered;
+            return true;
+        }
+
+#if defined(_WIN32)
+        static bool isRemote(const std::filesystem::path &path) noexcept {
+            wchar_t volume[MAX_PATH];
+            return ::GetVolumePathNameW(path.c_str(), volume, MAX_PATH) && ::GetDriveTypeW(volume) == DRIVE_REMOTE;
+        }
+
+        void open(std::string path, AccessHint hint, std::error_code &ec) {
+            ec.clear();
+            filePath = std::move(path);
+            const std::filesystem::path nativePath(filePath);
+            const DWORD flags = hint == AccessHint::sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                                : hint == AccessHint::random   ? FILE_FLAG_RANDOM_ACCESS
+                                                               : FILE_ATTRIBUTE_NORMAL;
+            handle = ::CreateFileW(nativePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_EXISTING, flags, nullptr);
+            if (handle == INVALID_HANDLE_VALUE) {
+                ec.assign(static_cast<int>(::GetLastError()), std::system_category());
+                return;
+            }
+            LARGE_INTEGER size{};
+            if (::GetFileType(handle) == FILE_TYPE_DISK && ::GetFileSizeEx(handle, &size) && size.QuadPart > 0 && !isRemote(nativePath) &&
+                static_cast<std::uint64_t>(size.QuadPart) <= std::numeric_limits<std::size_t>::max()) {
+                const auto bytes = static_cast<std::size_t>(size.QuadPart);
+                if (bytes < mapThreshold) {
+                    const bool ok = readAll(bytes, [this](std::byte *out, std::size_t count) -> std::ptrdiff_t {
+                        DWORD got = 0;
+                        if (!::ReadFile(handle, out, static_cast<DWORD>(std::min<std::size_t>(count, MAXDWORD)), &got, nullptr))
+                            return -1;
+                        return static_cast<std::ptrdiff_t>(got);
+                    });
+                    if (!ok)
+                        ec.assign(static_cast<int>(::GetLastError()), std::system_category());
+                    ::CloseHandle(handle);
+                    handle = INVALID_HANDLE_VALUE;
+                    if (ec)
+                        close();
+                    return;
+                }
+                HANDLE mapping = ::CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mapping) {
+                    const void *address = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                    ::CloseHandle(mapping);
+                    if (address) {
+                        ::CloseHandle(handle);
+                        handle = INVALID_HANDLE_VALUE;
+                        view = static_cast<const std::byte *>(address);
+                        length = bytes;
+                        fileMode = Mode::mapped;
+                        return;
+                    }
+                }
+            }
+            fileMode = Mode::stream;
+        }
+
+        std::size_t readStream(std::byte *out, std::size_t count) {
+            DWORD got = 0;
+            if (!::ReadFile(handle, out, static_cast<DWORD>(std::min<std::size_t>(count, MAXDWORD)), &got, nullptr)) {
+                if (::GetLastError() == ERROR_BROKEN_PIPE) {
+                    streamEnd = true;
+                    return 0;
+                }
+                throw ex::FileError("Failed to read file: " + filePath);
+            }
+            streamEnd = got == 0;
+            return got;
+        }
+
+        HANDLE handle = INVALID_HANDLE_VALUE;
+#elif defined(__unix__) || defined(__APPLE__)
+        // Mapped pages of a network filesystem can fault with SIGBUS when the server side changes
+        static bool isRemote(int fd) noexcept {
+#if defined(__linux__)
+            struct statfs info {};
+            if (::fstatfs(fd, &info) != 0)
+                return false;
+            switch (static_cast<unsigned long>(info.f_type)) {
+            case 0x6969UL:     // NFS
+            case 0x517BUL:     // SMB
+            case 0xFF534D42UL: // CIFS
+            case 0xFE534D42UL: // SMB2
+                return true;
+            default:
+                return false;
+            }
+#elif defined(__APPLE__)
+            struct statfs info {};
+            return ::fstatfs(fd, &info) == 0 && !(info.f_flags & MNT_LOCAL);
+#else
+            static_cast<void>(fd);
+            return false;
+#endif
+        }
+
+        void open(std::string path, AccessHint hint, std::error_code &ec) {
+            ec.clear();
+            filePath = std::move(path);
+            fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                ec.assign(errno, std::system_category());
+                return;
+            }
+            struct stat info {};
+            if (::fstat(fd, &info) != 0) {
+                ec.assign(errno, std::system_category());
+                close();
+                return;
+            }
+            // Size 0 is also reported for files generated on read, such as those under /proc
+            if (S_ISREG(info.st_mode) && info.st_size > 0 && !isRemote(fd) &&
+                static_cast<std::uint64_t>(info.st_size) <= std::numeric_limits<std::size_t>::max()) {
+                const auto bytes = static_cast<std::size_t>(info.st_size);
+                if (bytes < mapThreshold) {
+                    const bool ok = readAll(bytes, [this](std::byte *out, std::size_t count) -> std::ptrdiff_t {
+                        ssize_t got;
+                        do {
+                            got = ::read(fd, out, count);
+                        } while (got < 0 && errno == EINTR);
+                        return static_cast<std::ptrdiff_t>(got);
+                    });
+                    if (!ok)
+                        ec.assign(errno, std::system_category());
+                    ::close(fd);
+                    fd = -1;
+                    if (ec)
+                        close();
+                    return;
+                }
+                void *address = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address != MAP_FAILED) {
+                    const int advice = hint == AccessHint::sequential ? MADV_SEQUENTIAL
+                                       : hint == AccessHint::random   ? MADV_RANDOM
+                                                                      : MADV_NORMAL;
+                    ::madvise(address, bytes, advice);
+                    ::close(fd);
+                    fd = -1;
+                    view = static_cast<const std::byte *>(address);
+                    length = bytes;
+                    fileMode = Mode::mapped;
+                    return;
+                }
+            }
+            fileMode = Mode::stream;
+        }
+
+        std::size_t readStream(std::byte *out, std::size_t count) {
+            ssize_t got;
+            do {
+                got = ::read(fd, out, count);
+            } while (got < 0 && errno == EINTR);
+            if (got < 0)
+                throw ex::FileError("Failed to read file: " + filePath);
+            streamEnd = got == 0;
+            return static_cast<std::size_t>(got);
+        }
+
+        int fd = -1;
+#endif
+
+        std::string filePath;
+        const std::byte *view = nullptr;
+        std::size_t length = 0;
+        std::vector<std::byte> owned;
+        std::vector<std::byte> peeked;
+        bool streamEnd = false;
+        Mode fileMode = Mode::closed;
+    };
+
+} // namespace neko::util::fs
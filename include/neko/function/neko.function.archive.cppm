@@ -3,17 +3,40 @@ module;
 // ====================
 // = Standard Library =
 // ====================
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <fstream>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stop_token>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
-#include <cstring>
-#include <filesystem>
 
 // =====================
 // = Archive Support ==
 // =====================
 #include <minizip-ng/mz.h>
+#include <minizip-ng/mz_os.h>
 #include <minizip-ng/mz_strm.h>
+#include <minizip-ng/mz_strm_mem.h>
 #include <minizip-ng/mz_zip.h>
 #include <minizip-ng/mz_zip_rw.h>
 
@@ -9,20 +9,89 @@ module;
 // ====================
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <cerrno>
 #include <chrono>
+#include <compare>
+#include <condition_variable>
+#include <coroutine>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
+#include <initializer_list>
 #include <iomanip>
+#include <iterator>
+#include <istream>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <ostream>
 #include <random>
+#include <ranges>
 #include <regex>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
 #include <vector>
 
+// ====================
+// ===== Platform =====
+// ====================
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <bcrypt.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/random.h>
+#include <sys/vfs.h>
+#elif defined(__APPLE__)
+#include <sys/mount.h>
+#include <sys/param.h>
+#endif
+#endif
+
+// ====================
+// ==== Intrinsics ====
+// ====================
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
 // ====================
 // === Hash Support ===
 // ====================
@@ -50,9 +119,16 @@ import neko.schema;
 #define NEKO_FUNCTION_ENABLE_MODULE true
 
 export {
-    #include "pattern.hpp"
+    #include "profile.hpp"
+    #include "threadPool.hpp"
+    #include "mappedFile.hpp"
+    #include "base64.hpp"
     #include "utilities.hpp"
+    #include "pipeline.hpp"
+    #include "pattern.hpp"
+    #include "walker.hpp"
     #include "detectFileType.hpp"
+    #include "fastHash.hpp"
     #include "hash.hpp"
     #include "uuid.hpp"
 }
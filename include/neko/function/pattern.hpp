@@ -3,10 +3,20 @@
 // Include header for non-module usage
 #if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
 
+#include <neko/function/profile.hpp>
+#include <neko/function/utilities.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <regex>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
 
 #endif
@@ -40,8 +50,322 @@ namespace neko::util::pattern {
      * @param pattern The pattern string.
      * @return True if the pattern is an extension pattern, false otherwise.
      */
-    inline bool isExtensionPattern(const std::string &pattern) {
-        return !pattern.empty() && pattern[0] == '.' && pattern.find('/', 0) == std::string::npos;
+    constexpr bool isExtensionPattern(std::string_view pattern) noexcept {
+        return !pattern.empty() && pattern[0] == '.' && pattern.find('/') == std::string_view::npos;
+    }
+
+    namespace detail {
+        /**
+         * @brief Transparent string hash, allows std::string_view lookups without allocating a key.
+         */
+        struct StringHash {
+            using is_transparent = void;
+            std::size_t operator()(std::string_view str) const noexcept {
+                return std::hash<std::string_view>{}(str);
+            }
+        };
+
+        using StringSet = std::unordered_set<std::string, StringHash, std::equal_to<>>;
+
+        /**
+         * @brief Get the filename component of a path, same as std::filesystem::path::filename().
+         */
+        constexpr std::string_view filenameOf(std::string_view path) noexcept {
+#if defined(_WIN32)
+            auto pos = path.find_last_of("/\\");
+#else
+            auto pos = path.find_last_of('/');
+#endif
+            return pos == std::string_view::npos ? path : path.substr(pos + 1);
+        }
+
+        /**
+         * @brief Check whether a path is already in std::filesystem lexically normal, generic form.
+         * This is a conservative check: false only means the path has to be normalized first.
+         */
+        constexpr bool isLexicallyNormal(std::string_view path) noexcept {
+            std::size_t start = (!path.empty() && path[0] == '/') ? 1 : 0;
+            while (start < path.size()) {
+                std::size_t end = path.find('/', start);
+                if (end == std::string_view::npos) {
+                    end = path.size();
+                }
+                std::string_view component = path.substr(start, end - start);
+                if (component.empty() || component == "." || component == "..") {
+                    return false;
+                }
+#if defined(_WIN32)
+                if (component.find_first_of("\\:") != std::string_view::npos) {
+                    return false;
+                }
+#endif
+                start = end + 1;
+            }
+            return true;
+        }
+
+    } // namespace detail
+
+    /**
+     * @enum WildcardMode
+     * @brief Selects how wildcard patterns are interpreted.
+     */
+    enum class WildcardMode {
+        glob,  ///< Glob syntax: '*', '**', '?', '[abc]', '[!a-z]' and backslash escapes, matched without backtracking
+        legacy ///< Original behavior: only '*' is special, directory patterns match by prefix search
+    };
+
+    /**
+     * @class Glob
+     * @brief A compiled glob pattern matched without regex or recursion.
+     *
+     * Syntax:
+     * - '*' matches any sequence of characters except '/'.
+     * - '**' matches any sequence of characters including '/'. When it forms a whole path segment
+     *   it also matches zero directories, so a pattern like "a/ ** /b" (without spaces) matches "a/b" and "a/x/y/b".
+     * - '?' matches one character except '/'.
+     * - '[abc]', '[a-z]', '[!a-z]' or '[^a-z]' match one character (never '/') of the class.
+     * - A backslash escapes the next character.
+     *
+     * The pattern is compiled into a token list and simulated as an NFA with a bitset of active
+     * states, so a match is O(text length x pattern length): linear in the text for a given pattern,
+     * with no backtracking and no exponential cases.
+     * Patterns of up to 255 tokens are matched without allocation.
+     */
+    class Glob {
+    public:
+        Glob() = default;
+
+        explicit Glob(std::string_view pattern) : source(pattern) {
+            compile(pattern);
+        }
+
+        /**
+         * @brief Match the whole text against the pattern.
+         * @param text The text to match (usually a path with '/' separators).
+         * @return True if the entire text matches.
+         */
+        bool match(std::string_view text) const {
+            const std::size_t stateCount = tokens.size() + 1;
+            const std::size_t words = (stateCount + 63) / 64;
+            std::uint64_t inlineStates[2][inlineWords];
+            std::vector<std::uint64_t> heapStates;
+            std::uint64_t *current = inlineStates[0];
+            std::uint64_t *next = inlineStates[1];
+            if (words > inlineWords) {
+                heapStates.resize(words * 2);
+                current = heapStates.data();
+                next = heapStates.data() + words;
+            }
+
+            std::fill(current, current + words, 0);
+            current[0] = 1;
+            closure(current);
+
+            for (char c : text) {
+                std::fill(next, next + words, 0);
+                bool any = false;
+                for (std::size_t i = 0; i < tokens.size(); ++i) {
+                    if (!(current[i / 64] & (std::uint64_t{1} << (i % 64)))) {
+                        continue;
+                    }
+                    std::size_t target = step(tokens[i], c, i);
+                    if (target != npos) {
+                        next[target / 64] |= std::uint64_t{1} << (target % 64);
+                        any = true;
+                    }
+                }
+                if (!any) {
+                    return false;
+                }
+                closure(next);
+                std::swap(current, next);
+            }
+            return (current[tokens.size() / 64] >> (tokens.size() % 64)) & 1;
+        }
+
+        /**
+         * @brief Get the source pattern.
+         */
+        const std::string &pattern() const noexcept {
+            return source;
+        }
+
+    private:
+        enum class Kind : std::uint8_t {
+            literal,
+            any,
+            charClass,
+            star,
+            doubleStar,
+            doubleStarDir // "**" followed by '/', may be skipped together with that '/'
+        };
+
+        struct Token {
+            Kind kind;
+            char ch = 0;              // literal character
+            std::uint32_t charSet = 0; // index into classes
+        };
+
+        using CharSet = std::array<std::uint64_t, 4>;
+
+        static constexpr std::size_t inlineWords = 4;
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        static bool inSet(const CharSet &set, unsigned char c) noexcept {
+            return (set[c / 64] >> (c % 64)) & 1;
+        }
+
+        static void addToSet(CharSet &set, unsigned char c) noexcept {
+            set[c / 64] |= std::uint64_t{1} << (c % 64);
+        }
+
+        std::size_t step(const Token &token, char c, std::size_t index) const noexcept {
+            switch (token.kind) {
+                case Kind::literal:
+                    return token.ch == c ? index + 1 : npos;
+                case Kind::any:
+                    return c != '/' ? index + 1 : npos;
+                case Kind::charClass:
+                    return (c != '/' && inSet(classes[token.charSet], static_cast<unsigned char>(c))) ? index + 1 : npos;
+                case Kind::star:
+                    return c != '/' ? index : npos;
+                case Kind::doubleStar:
+                case Kind::doubleStarDir:
+                    return index;
+            }
+            return npos;
+        }
+
+        // Epsilon transitions only point forward, so one ascending pass reaches the full closure
+        void closure(std::uint64_t *states) const noexcept {
+            for (std::size_t i = 0; i < tokens.size(); ++i) {
+                if (!(states[i / 64] & (std::uint64_t{1} << (i % 64)))) {
+                    continue;
+                }
+                Kind kind = tokens[i].kind;
+                if (kind == Kind::star || kind == Kind::doubleStar || kind == Kind::doubleStarDir) {
+                    states[(i + 1) / 64] |= std::uint64_t{1} << ((i + 1) % 64);
+                }
+                if (kind == Kind::doubleStarDir) {
+                    states[(i + 2) / 64] |= std::uint64_t{1} << ((i + 2) % 64);
+                }
+            }
+        }
+
+        void compile(std::string_view p) {
+            std::size_t i = 0;
+            while (i < p.size()) {
+                char c = p[i];
+                if (c == '\\' && i + 1 < p.size()) {
+                    tokens.push_back({Kind::literal, p[i + 1]});
+                    i += 2;
+                } else if (c == '*') {
+                    std::size_t j = i;
+                    while (j < p.size() && p[j] == '*') {
+                        ++j;
+                    }
+                    if (j - i == 1) {
+                        tokens.push_back({Kind::star});
+                    } else if (j < p.size() && p[j] == '/' && (i == 0 || p[i - 1] == '/')) {
+                        tokens.push_back({Kind::doubleStarDir});
+                    } else {
+                        tokens.push_back({Kind::doubleStar});
+                    }
+                    i = j;
+                } else if (c == '?') {
+                    tokens.push_back({Kind::any});
+                    ++i;
+                } else if (c == '[') {
+                    i = compileClass(p, i);
+                } else {
+                    tokens.push_back({Kind::literal, c});
+                    ++i;
+                }
+            }
+        }
+
+        // Parses a bracket expression starting at p[open] == '[', an unterminated '[' is a literal
+        std::size_t compileClass(std::string_view p, std::size_t open) {
+            std::size_t k = open + 1;
+            bool negate = k < p.size() && (p[k] == '!' || p[k] == '^');
+            if (negate) {
+                ++k;
+            }
+            CharSet set{};
+            bool first = true;
+            while (k < p.size() && (p[k] != ']' || first)) {
+                first = false;
+                unsigned char lo = static_cast<unsigned char>(p[k]);
+                if (p[k] == '\\' && k + 1 < p.size()) {
+                    lo = static_cast<unsigned char>(p[++k]);
+                }
+                ++k;
+                if (k + 1 < p.size() && p[k] == '-' && p[k + 1] != ']') {
+                    unsigned char hi = static_cast<unsigned char>(p[k + 1]);
+                    k += 2;
+                    for (unsigned int ch = lo; ch <= hi; ++ch) {
+                        addToSet(set, static_cast<unsigned char>(ch));
+                    }
+                } else {
+                    addToSet(set, lo);
+                }
+            }
+            if (k >= p.size()) {
+                tokens.push_back({Kind::literal, '['});
+                return open + 1;
+            }
+            if (negate) {
+                for (auto &word : set) {
+                    word = ~word;
+                }
+            }
+            tokens.push_back({Kind::charClass, 0, static_cast<std::uint32_t>(classes.size())});
+            classes.push_back(set);
+            return k + 1;
+        }
+
+        std::string source;
+        std::vector<Token> tokens;
+        std::vector<CharSet> classes;
+    };
+
+    /**
+     * @brief Match a whole text against a glob pattern.
+     * @param text The text to match.
+     * @param pattern The glob pattern, see Glob for the syntax.
+     * @return True if the entire text matches the pattern.
+     * @note Compiles the pattern on every call, use Glob to reuse it.
+     */
+    inline bool globMatch(std::string_view text, std::string_view pattern) {
+        return Glob(pattern).match(text);
+    }
+
+    /**
+     * @brief Check if the pattern uses glob syntax ('*', '?' or '[').
+     * @param pattern The pattern string.
+     * @return True if the pattern contains a glob metacharacter, false otherwise.
+     */
+    inline bool containsGlob(std::string_view pattern) {
+        return pattern.find_first_of("*?[") != std::string_view::npos;
+    }
+
+    /**
+     * @brief Convert a path pattern to the equivalent glob over a whole normalized path.
+     * Absolute patterns are anchored at the root, relative patterns may start at any directory level,
+     * and a trailing '/' also matches everything below the directory.
+     * @param pattern A pattern containing '/'.
+     */
+    inline std::string anchorPathGlob(std::string_view pattern) {
+        std::string anchored;
+        if (pattern.empty() || pattern[0] != '/') {
+            anchored = "**/";
+        }
+        anchored += pattern;
+        if (!pattern.empty() && pattern.back() == '/') {
+            anchored += "**";
+        }
+        return anchored;
     }
 
     /**
@@ -85,14 +409,32 @@ namespace neko::util::pattern {
 
     /**
      * @brief Match a target string against a wildcard pattern.
+     *
+     * In WildcardMode::glob (see Glob for the syntax):
+     * - A pattern without '/' is matched against the target's filename.
+     * - An absolute pattern is matched against the whole target.
+     * - A relative pattern may start at any directory level, so a pattern for "src/a.cpp" also matches "lib/src/a.cpp".
+     * - A pattern ending with '/' also matches everything below the directory.
+     *
+     * WildcardMode::legacy keeps the original regex based behavior.
+     *
      * @param target The target string (file path).
      * @param pattern The wildcard pattern.
+     * @param mode How to interpret the pattern.
      * @return True if the target matches the pattern, false otherwise.
      */
-    inline bool matchWildcardPattern(const std::string &target, const std::string &pattern) {
+    inline bool matchWildcardPattern(const std::string &target, const std::string &pattern, WildcardMode mode = WildcardMode::glob) {
+        NEKO_FUNCTION_PROFILE_SCOPE(timer, "pattern.matchWildcardPattern");
         if (pattern == "*")
             return true;
 
+        if (mode == WildcardMode::glob) {
+            if (pattern.find('/') == std::string::npos) {
+                return Glob(pattern).match(detail::filenameOf(target));
+            }
+            return Glob(anchorPathGlob(pattern)).match(target);
+        }
+
         // Convert wildcard pattern to regex string
         std::string regexStr = wildcardToRegexString(pattern);
 
@@ -158,9 +500,8 @@ namespace neko::util::pattern {
      * @param pattern The extension pattern (e.g., ".txt").
      * @return True if the file extension matches the pattern, false otherwise.
      */
-    inline bool matchExtension(const std::string &target, const std::string &pattern) {
-        std::string targetExtension = std::filesystem::path(target).extension().string();
-        return targetExtension == pattern;
+    constexpr bool matchExtension(std::string_view target, std::string_view pattern) noexcept {
+        return isExtensionPattern(pattern) && pattern.size() > 1 && string::getExtensionView(target) == pattern.substr(1);
     }
 
     /**
@@ -235,9 +576,12 @@ namespace neko::util::pattern {
      * @brief Match the target path against any of the provided patterns.
      * @param target The target file path.
      * @param patterns A vector of pattern strings.
+     * @param mode How to interpret wildcard patterns.
      * @return True if the target matches any pattern, false otherwise.
+     * @note When matching many targets against the same patterns, build a CompiledPatternSet once instead.
      */
-    inline bool matchAny(const std::string &target, const std::vector<std::string> &patterns) {
+    inline bool matchAny(const std::string &target, const std::vector<std::string> &patterns, WildcardMode mode = WildcardMode::glob) {
+        NEKO_FUNCTION_PROFILE_SCOPE(timer, "pattern.matchAny");
         std::string normalizedTarget = std::filesystem::path(target).lexically_normal().generic_string();
         std::string filename = std::filesystem::path(target).filename().string();
 
@@ -246,8 +590,8 @@ namespace neko::util::pattern {
                 continue;
 
             // Handle wildcard pattern (check first, as it may contain other pattern features)
-            if (containsWildcard(pattern)) {
-                if (matchWildcardPattern(normalizedTarget, pattern)) {
+            if (mode == WildcardMode::glob ? containsGlob(pattern) : containsWildcard(pattern)) {
+                if (matchWildcardPattern(normalizedTarget, pattern, mode)) {
                     return true;
                 }
                 continue;
@@ -299,4 +643,284 @@ namespace neko::util::pattern {
 
         return false;
     }
+
+    /**
+     * @class CompiledPatternSet
+     * @brief A set of patterns pre-processed once for repeated matching.
+     *
+     * Accepts the same pattern syntax as matchAny, but sorts the patterns into hash sets
+     * (exact names, extensions, "*.ext" suffixes, absolute files, directory prefixes, directory names,
+     * relative path suffixes) and pre-split wildcard patterns. match() performs no allocation for
+     * targets that are already lexically normal (e.g. zip entry names), and no regex is ever built.
+     *
+     * @example
+     * CompiledPatternSet excludes({"*.tmp", "cache/", ".log"});
+     * for (const auto &name : entries)
+     *     if (!excludes.match(name)) { ... }
+     *
+     * @note Wildcard patterns are compiled to Glob objects once, in either WildcardMode.
+     */
+    class CompiledPatternSet {
+    public:
+        CompiledPatternSet() = default;
+
+        explicit CompiledPatternSet(const std::vector<std::string> &patterns, WildcardMode mode = WildcardMode::glob)
+            : mode(mode) {
+            NEKO_FUNCTION_PROFILE_SCOPE(timer, "pattern.CompiledPatternSet.compile");
+            for (const auto &pattern : patterns) {
+                add(pattern);
+            }
+        }
+
+        /**
+         * @brief Add a pattern to the set.
+         * @param pattern The pattern string, empty patterns are ignored.
+         */
+        void add(const std::string &pattern) {
+            if (pattern.empty()) {
+                return;
+            }
+            hasPatterns = true;
+
+            if (mode == WildcardMode::glob ? containsGlob(pattern) : containsWildcard(pattern)) {
+                addWildcard(pattern);
+                return;
+            }
+
+            if (isExtensionPattern(pattern)) {
+                extensions.insert(pattern);
+                return;
+            }
+
+            std::string normalizedPattern = std::filesystem::path(pattern).lexically_normal().generic_string();
+            bool isAbsolutePattern = pattern[0] == '/';
+            bool isDirPattern = isPatternDir(pattern);
+
+            if (isDirPattern) {
+                if (!normalizedPattern.empty() && normalizedPattern.back() == '/') {
+                    normalizedPattern.pop_back();
+                }
+                (isAbsolutePattern ? absoluteDirs : dirNames).insert(std::move(normalizedPattern));
+            } else if (isAbsolutePattern) {
+                absoluteFiles.insert(std::move(normalizedPattern));
+            } else {
+                names.insert(pattern);
+                pathSuffixes.insert(std::move(normalizedPattern));
+            }
+        }
+
+        /**
+         * @brief Check whether the set contains no patterns.
+         */
+        bool empty() const noexcept {
+            return !hasPatterns;
+        }
+
+        /**
+         * @brief Match the target path against the patterns in the set.
+         * @param target The target file path.
+         * @return True if the target matches any pattern, false otherwise (always false for an empty set).
+         */
+        bool match(std::string_view target) const {
+            if (!hasPatterns) {
+                return false;
+            }
+            if (matchAll) {
+                return true;
+            }
+            if (detail::isLexicallyNormal(target)) {
+                return matchNormalized(target, target);
+            }
+            std::string normalizedTarget = std::filesystem::path(target).lexically_normal().generic_string();
+            return matchNormalized(normalizedTarget, target);
+        }
+
+        /**
+         * @brief Check whether every path under a directory matches, so a directory walk can skip it.
+         *
+         * Directory names ("logs/"), absolute directories ("/path/to/logs/") and globs ending in
+         * '/' or a trailing "**" segment are considered. The check is conservative: false means some path below the
+         * directory may not match, and its files still have to be matched one by one.
+         * @param directory The directory path, in the same form as the file paths given to match().
+         */
+        bool matchDirectory(std::string_view directory) const {
+            if (!hasPatterns) {
+                return false;
+            }
+            if (matchAll) {
+                return true;
+            }
+            std::string normalized;
+            std::string_view target = directory;
+            if (!detail::isLexicallyNormal(target)) {
+                normalized = std::filesystem::path(target).lexically_normal().generic_string();
+                target = normalized;
+            }
+            if (!target.empty() && target.back() == '/') {
+                target.remove_suffix(1);
+            }
+
+            if (absoluteDirs.find(target) != absoluteDirs.end() || matchSubtreeGlob(target)) {
+                return true;
+            }
+            for (auto slash = target.find('/'); slash != std::string_view::npos; slash = target.find('/', slash + 1)) {
+                std::string_view prefix = target.substr(0, slash);
+                if (absoluteDirs.find(prefix) != absoluteDirs.end() || matchSubtreeGlob(prefix)) {
+                    return true;
+                }
+                std::string_view rest = target.substr(slash + 1);
+                if (dirNames.find(rest.substr(0, rest.find('/'))) != dirNames.end()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        struct DirectoryGlob {
+            std::string dirPrefix; // Literal prefix up to and including the last '/'
+            Glob filePattern;      // Pattern for the following path component
+            bool absolute;
+        };
+
+        // In legacy mode only '*' is special
+        static std::string escapeLegacy(std::string_view pattern) {
+            std::string escaped;
+            escaped.reserve(pattern.size());
+            for (char c : pattern) {
+                if (c == '?' || c == '[' || c == '\\') {
+                    escaped += '\\';
+                }
+                escaped += c;
+            }
+            return escaped;
+        }
+
+        void addWildcard(const std::string &pattern) {
+            if (pattern == "*" || (mode == WildcardMode::glob && pattern == "**")) {
+                matchAll = true;
+                return;
+            }
+            auto lastSlash = pattern.find_last_of('/');
+            if (lastSlash == std::string::npos) {
+                // "*.ext" is a plain suffix test on the filename
+                std::string_view rest = std::string_view(pattern).substr(1);
+                if (pattern[0] == '*' && rest.size() > 1 && rest[0] == '.' && rest.find_first_of("*?[\\.", 1) == std::string_view::npos) {
+                    filenameSuffixes.emplace(rest);
+                } else {
+                    filenameGlobs.emplace_back(mode == WildcardMode::glob ? pattern : escapeLegacy(pattern));
+                }
+                return;
+            }
+            if (mode == WildcardMode::glob) {
+                std::string anchored = anchorPathGlob(pattern);
+                // "X/**" matches everything below any directory matching X
+                if (anchored.size() > 3 && anchored.compare(anchored.size() - 3, 3, "/**") == 0) {
+                    subtreeGlobs.emplace_back(std::string_view(anchored).substr(0, anchored.size() - 3));
+                }
+                pathGlobs.emplace_back(std::move(anchored));
+                return;
+            }
+            directoryGlobs.push_back({pattern.substr(0, lastSlash + 1), Glob(escapeLegacy(pattern.substr(lastSlash + 1))), pattern[0] == '/'});
+        }
+
+        bool matchSubtreeGlob(std::string_view directory) const {
+            for (const auto &glob : subtreeGlobs) {
+                if (glob.match(directory)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static bool matchDirectoryGlob(std::string_view target, const DirectoryGlob &glob) {
+            if (glob.absolute) {
+                if (target.substr(0, glob.dirPrefix.size()) != glob.dirPrefix) {
+                    return false;
+                }
+                auto targetLastSlash = target.find_last_of('/');
+                if (targetLastSlash == std::string_view::npos || targetLastSlash < glob.dirPrefix.size() - 1) {
+                    return false;
+                }
+                return glob.filePattern.match(target.substr(targetLastSlash + 1));
+            }
+            auto pos = target.find(glob.dirPrefix);
+            if (pos == std::string_view::npos) {
+                return false;
+            }
+            std::string_view dirSegment = target.substr(pos + glob.dirPrefix.size());
+            return glob.filePattern.match(dirSegment.substr(0, dirSegment.find('/')));
+        }
+
+        bool matchNormalized(std::string_view target, std::string_view original) const {
+            std::string_view filename = detail::filenameOf(target);
+
+            if (!names.empty() && names.find(detail::filenameOf(original)) != names.end()) {
+                return true;
+            }
+            if (!extensions.empty() && extensions.matches(filename)) {
+                return true;
+            }
+            if (!filenameSuffixes.empty()) {
+                auto dot = filename.rfind('.');
+                if (dot != std::string_view::npos && filenameSuffixes.find(filename.substr(dot)) != filenameSuffixes.end()) {
+                    return true;
+                }
+            }
+            if (!absoluteFiles.empty() && absoluteFiles.find(target) != absoluteFiles.end()) {
+                return true;
+            }
+
+            // Walk the path once, checking every directory prefix, directory name and path suffix
+            if (!absoluteDirs.empty() || !dirNames.empty() || !pathSuffixes.empty()) {
+                if (absoluteDirs.find(target) != absoluteDirs.end() || pathSuffixes.find(target) != pathSuffixes.end()) {
+                    return true;
+                }
+                for (auto slash = target.find('/'); slash != std::string_view::npos; slash = target.find('/', slash + 1)) {
+                    if (absoluteDirs.find(target.substr(0, slash)) != absoluteDirs.end()) {
+                        return true;
+                    }
+                    std::string_view rest = target.substr(slash + 1);
+                    if (pathSuffixes.find(rest) != pathSuffixes.end()) {
+                        return true;
+                    }
+                    if (dirNames.find(rest.substr(0, rest.find('/'))) != dirNames.end()) {
+                        return true;
+                    }
+                }
+            }
+
+            for (const auto &glob : filenameGlobs) {
+                if (glob.match(filename)) {
+                    return true;
+                }
+            }
+            for (const auto &glob : pathGlobs) {
+                if (glob.match(target)) {
+                    return true;
+                }
+            }
+            for (const auto &glob : directoryGlobs) {
+                if (matchDirectoryGlob(target, glob)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        WildcardMode mode = WildcardMode::glob;
+        bool hasPatterns = false;
+        bool matchAll = false;
+        detail::StringSet names;            // Relative file names, compared with the target's filename
+        string::ExtensionSet extensions{true}; // ".txt" stored as "txt", case-sensitive
+        detail::StringSet filenameSuffixes; // "*.txt" stored as ".txt"
+        detail::StringSet absoluteFiles;    // "/path/to/file.txt"
+        detail::StringSet absoluteDirs;     // "/path/to/logs/" stored as "/path/to/logs"
+        detail::StringSet dirNames;         // "logs/" stored as "logs"
+        detail::StringSet pathSuffixes;     // "user/abc.txt"
+        std::vector<Glob> filenameGlobs;           // Matched against the filename
+        std::vector<Glob> pathGlobs;               // Matched against the whole path (glob mode)
+        std::vector<Glob> subtreeGlobs;            // Path globs ending in "/**", without that suffix
+        std::vector<DirectoryGlob> directoryGlobs; // Prefix search + component glob (legacy mode)
+    };
 } // namespace neko::util::pattern
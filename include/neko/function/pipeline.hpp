@@ -0,0 +1,482 @@
+/**
+ * @file pipeline.hpp
+ * @brief Lazy and parallel range stages for pipe-style pipelines
+ * @author moehoshio
+ * @copyright Copyright (c) 2025 Hoshi
+ * @license MIT OR Apache-2.0
+ */
+
+#pragma once
+
+// Include header for non-module usage
+#if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
+
+#include <neko/function/threadPool.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#endif
+
+/**
+ * @namespace neko::ops::pipeline
+ * @brief Stages combined with operator| into lazy pipelines.
+ *
+ * map, filter, take and chunk return views; nothing is evaluated until the result is iterated
+ * or ends in foreach / collect. parallel(n) hands batches of the upstream elements to up to n threads
+ * of the shared pool, which run the stages after it (map, filter) and the terminal foreach / collect.
+ * The operators are found by argument-dependent lookup, no using-directive is needed.
+ * @code
+ * using namespace neko::ops::pipeline;
+ * paths | filter(isZip) | parallel(8) | foreach(hashFile);
+ * auto sizes = files | map(fileSize) | take(10) | collect();
+ * @endcode
+ */
+namespace neko::ops::pipeline {
+
+    template <typename F>
+    struct MapStage {
+        F fn;
+    };
+
+    template <typename P>
+    struct FilterStage {
+        P pred;
+    };
+
+    struct TakeStage {
+        std::size_t count;
+    };
+
+    struct ChunkStage {
+        std::size_t size;
+    };
+
+    struct ParallelStage {
+        std::size_t threads;
+        std::size_t chunkSize;
+    };
+
+    template <typename F>
+    struct ForeachStage {
+        F fn;
+    };
+
+    struct CollectStage {};
+
+    /**
+     * @brief Lazily applies fn to every element.
+     */
+    template <typename F>
+    constexpr MapStage<std::decay_t<F>> map(F &&fn) {
+        return {std::forward<F>(fn)};
+    }
+
+    /**
+     * @brief Lazily keeps the elements for which pred returns true.
+     */
+    template <typename P>
+    constexpr FilterStage<std::decay_t<P>> filter(P &&pred) {
+        return {std::forward<P>(pred)};
+    }
+
+    /**
+     * @brief Keeps at most the first count elements.
+     */
+    constexpr TakeStage take(std::size_t count) noexcept {
+        return {count};
+    }
+
+    /**
+     * @brief Groups consecutive elements into subranges of size elements (the last one may be shorter).
+     * @param size Elements per chunk, must be greater than 0.
+     */
+    constexpr ChunkStage chunk(std::size_t size) noexcept {
+        return {size};
+    }
+
+    /**
+     * @brief Runs the following stages and the terminal on threads of pool::defaultPool().
+     * The upstream range is iterated on the calling thread and split into batches; foreach callbacks
+     * therefore run concurrently and in no particular order, while collect keeps the upstream order.
+     * An exception thrown by a worker stops the pipeline and is rethrown on the calling thread.
+     * @param threads Maximum number of pool helpers, 0 uses the hardware concurrency.
+     * @param chunkSize Elements per batch, 0 picks a size from the range length (16 for unsized ranges).
+     */
+    constexpr ParallelStage parallel(std::size_t threads = 0, std::size_t chunkSize = 0) noexcept {
+        return {threads, chunkSize};
+    }
+
+    /**
+     * @brief Terminal stage: calls fn for every element.
+     */
+    template <typename F>
+    constexpr ForeachStage<std::decay_t<F>> foreach(F &&fn) {
+        return {std::forward<F>(fn)};
+    }
+
+    /**
+     * @brief Terminal stage: stores the elements in a std::vector.
+     */
+    constexpr CollectStage collect() noexcept {
+        return {};
+    }
+
+    /**
+     * @class ChunkView
+     * @brief Forward view of consecutive subranges of the underlying view.
+     */
+    template <std::ranges::view V>
+        requires std::ranges::forward_range<V>
+    class ChunkView : public std::ranges::view_interface<ChunkView<V>> {
+    public:
+        class Iterator {
+        public:
+            using BaseIterator = std::ranges::iterator_t<V>;
+            using BaseSentinel = std::ranges::sentinel_t<V>;
+            using value_type = std::ranges::subrange<BaseIterator>;
+            using difference_type = std::ranges::range_difference_t<V>;
+            using iterator_category = std::input_iterator_tag;
+            using iterator_concept = std::forward_iterator_tag;
+
+            Iterator() = default;
+            Iterator(BaseIterator current, BaseSentinel last, difference_type size)
+                : current(current), next(std::ranges::next(current, size, last)), last(last), size(size) {}
+
+            value_type operator*() const {
+                return {current, next};
+            }
+            Iterator &operator++() {
+                current = next;
+                next = std::ranges::next(next, size, last);
+                return *this;
+            }
+            Iterator operator++(int) {
+                auto previous = *this;
+                ++*this;
+                return previous;
+            }
+            bool operator==(const Iterator &other) const {
+                return current == other.current;
+            }
+            bool operator==(std::default_sentinel_t) const {
+                return current == last;
+            }
+
+        private:
+            BaseIterator current{};
+            BaseIterator next{};
+            BaseSentinel last{};
+            difference_type size = 1;
+        };
+
+        ChunkView() = default;
+        ChunkView(V base, std::size_t size)
+            : base(std::move(base)), size(static_cast<std::ranges::range_difference_t<V>>(std::max<std::size_t>(size, 1))) {}
+
+        Iterator begin() {
+            return Iterator(std::ranges::begin(base), std::ranges::end(base), size);
+        }
+        std::default_sentinel_t end() const noexcept {
+            return {};
+        }
+
+    private:
+        V base{};
+        std::ranges::range_difference_t<V> size = 1;
+    };
+
+    template <std::ranges::viewable_range R, typename F>
+    constexpr auto operator|(R &&range, MapStage<F> stage) {
+        return std::views::transform(std::forward<R>(range), std::move(stage.fn));
+    }
+
+    template <std::ranges::viewable_range R, typename P>
+    constexpr auto operator|(R &&range, FilterStage<P> stage) {
+        return std::views::filter(std::forward<R>(range), std::move(stage.pred));
+    }
+
+    template <std::ranges::viewable_range R>
+    constexpr auto operator|(R &&range, TakeStage stage) {
+        return std::views::take(std::forward<R>(range), static_cast<std::ranges::range_difference_t<R>>(stage.count));
+    }
+
+    template <std::ranges::viewable_range R>
+        requires std::ranges::forward_range<R>
+    constexpr auto operator|(R &&range, ChunkStage stage) {
+        return ChunkView<std::views::all_t<R>>(std::views::all(std::forward<R>(range)), stage.size);
+    }
+
+    template <std::ranges::input_range R, typename F>
+    constexpr void operator|(R &&range, ForeachStage<F> stage) {
+        for (auto &&elem : range) {
+            std::invoke(stage.fn, std::forward<decltype(elem)>(elem));
+        }
+    }
+
+    template <std::ranges::input_range R>
+    auto operator|(R &&range, CollectStage) {
+        std::vector<std::remove_cvref_t<std::ranges::range_reference_t<R>>> result;
+        if constexpr (std::ranges::sized_range<R>) {
+            result.reserve(static_cast<std::size_t>(std::ranges::size(range)));
+        }
+        for (auto &&elem : range) {
+            result.emplace_back(std::forward<decltype(elem)>(elem));
+        }
+        return result;
+    }
+
+    namespace detail {
+
+        constexpr std::size_t unsizedChunkSize = 16;
+
+        /**
+         * @brief Elements of a batch: pointers into the upstream range when it yields lvalues, copies otherwise.
+         */
+        template <typename V>
+        using BatchElement = std::conditional_t<std::is_lvalue_reference_v<std::ranges::range_reference_t<V>>,
+                                                std::remove_reference_t<std::ranges::range_reference_t<V>> *,
+                                                std::remove_cvref_t<std::ranges::range_reference_t<V>>>;
+
+        template <typename V>
+        auto batchView(std::vector<BatchElement<V>> &batch) {
+            if constexpr (std::is_lvalue_reference_v<std::ranges::range_reference_t<V>>) {
+                return std::views::transform(batch, [](auto *elem) -> decltype(auto) { return *elem; });
+            } else {
+                return std::views::all(batch);
+            }
+        }
+
+        /**
+         * @brief Iterates base on the calling thread and runs consume(batchIndex, batchView) on pool threads.
+         * At most two batches per helper are queued; when the queue is full, or no helper has started,
+         * the calling thread runs batches itself, so memory stays bounded and nested use cannot deadlock.
+         */
+        template <typename V, typename Consume>
+        void runParallel(V &base, std::size_t threads, std::size_t chunkSize, Consume consume) {
+            using Batch = std::vector<BatchElement<V>>;
+            if (threads == 0) {
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            if (chunkSize == 0) {
+                if constexpr (std::ranges::sized_range<V>) {
+                    auto size = static_cast<std::size_t>(std::ranges::size(base));
+                    chunkSize = std::clamp<std::size_t>((size + threads * 4 - 1) / (threads * 4), 1, 1024);
+                } else {
+                    chunkSize = unsizedChunkSize;
+                }
+            }
+
+            std::mutex mutex;
+            std::condition_variable ready;
+            std::deque<std::pair<std::size_t, Batch>> queue;
+            bool done = false;
+            bool failed = false;
+            std::exception_ptr error;
+
+            auto runBatch = [&](std::pair<std::size_t, Batch> &item) {
+                try {
+                    auto view = batchView<V>(item.second);
+                    consume(item.first, view);
+                    return true;
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!failed) {
+                        failed = true;
+                        error = std::current_exception();
+                    }
+                    ready.notify_all();
+                    return false;
+                }
+            };
+
+            auto worker = [&] {
+                while (true) {
+                    std::pair<std::size_t, Batch> item;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        ready.wait(lock, [&] { return !queue.empty() || done || failed; });
+                        if (failed || queue.empty())
+                            return;
+                        item = std::move(queue.front());
+                        queue.pop_front();
+                    }
+                    if (!runBatch(item))
+                        return;
+                }
+            };
+
+            // Declared after the shared state, so unstarted helpers are skipped and started ones joined first.
+            // Helpers are posted as batches arrive, so short ranges do not occupy idle pool threads
+            util::pool::TaskGroup helpers;
+            std::size_t posted = 0;
+            auto push = [&](std::size_t index, Batch &&batch) {
+                if (posted < threads && posted <= index) {
+                    helpers.run(worker);
+                    ++posted;
+                }
+                std::pair<std::size_t, Batch> item(index, std::move(batch));
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (failed)
+                        return false;
+                    if (queue.size() < threads * 2) {
+                        queue.push_back(std::move(item));
+                        ready.notify_one();
+                        return true;
+                    }
+                }
+                return runBatch(item);
+            };
+
+            try {
+                Batch batch;
+                batch.reserve(chunkSize);
+                std::size_t index = 0;
+                bool running = true;
+                for (auto &&elem : base) {
+                    if constexpr (std::is_pointer_v<BatchElement<V>>) {
+                        batch.push_back(std::addressof(elem));
+                    } else {
+                        batch.push_back(std::forward<decltype(elem)>(elem));
+                    }
+                    if (batch.size() == chunkSize) {
+                        if (!(running = push(index++, std::move(batch))))
+                            break;
+                        batch = Batch();
+                        batch.reserve(chunkSize);
+                    }
+                }
+                if (running && !batch.empty()) {
+                    push(index, std::move(batch));
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failed) {
+                    failed = true;
+                    error = std::current_exception();
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                done = true;
+            }
+            ready.notify_all();
+            // Helpers that never started leave their batches to the calling thread
+            worker();
+            helpers.wait();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        struct IdentityTail {
+            template <typename Chunk>
+            auto operator()(Chunk &chunk) const {
+                return std::views::all(chunk);
+            }
+        };
+
+        template <typename Tail, typename Stage>
+        struct ComposedTail {
+            Tail tail;
+            Stage stage;
+
+            template <typename Chunk>
+            auto operator()(Chunk &chunk) const {
+                return tail(chunk) | stage;
+            }
+        };
+
+    } // namespace detail
+
+    /**
+     * @class ParallelView
+     * @brief Pending pipeline split at parallel(); the stages after it run per batch when a terminal is applied.
+     */
+    template <std::ranges::view V, typename Tail = detail::IdentityTail>
+    class ParallelView {
+    public:
+        ParallelView(V base, ParallelStage settings, Tail tail = {})
+            : base(std::move(base)), settings(settings), tail(std::move(tail)) {}
+
+        template <typename F>
+        friend auto operator|(ParallelView view, MapStage<F> stage) {
+            return view.then(std::move(stage));
+        }
+
+        template <typename P>
+        friend auto operator|(ParallelView view, FilterStage<P> stage) {
+            return view.then(std::move(stage));
+        }
+
+        template <typename F>
+        friend void operator|(ParallelView view, ForeachStage<F> stage) {
+            detail::runParallel(view.base, view.settings.threads, view.settings.chunkSize, [&](std::size_t, auto &chunk) {
+                for (auto &&elem : view.tail(chunk)) {
+                    std::invoke(stage.fn, std::forward<decltype(elem)>(elem));
+                }
+            });
+        }
+
+        friend auto operator|(ParallelView view, CollectStage) {
+            using Chunk = decltype(detail::batchView<V>(std::declval<std::vector<detail::BatchElement<V>> &>()));
+            using Value = std::remove_cvref_t<std::ranges::range_reference_t<std::invoke_result_t<const Tail &, Chunk &>>>;
+            std::mutex mutex;
+            std::vector<std::vector<Value>> parts;
+            detail::runParallel(view.base, view.settings.threads, view.settings.chunkSize, [&](std::size_t index, auto &chunk) {
+                std::vector<Value> part;
+                for (auto &&elem : view.tail(chunk)) {
+                    part.emplace_back(std::forward<decltype(elem)>(elem));
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                if (parts.size() <= index) {
+                    parts.resize(index + 1);
+                }
+                parts[index] = std::move(part);
+            });
+
+            std::vector<Value> result;
+            std::size_t total = 0;
+            for (const auto &part : parts) {
+                total += part.size();
+            }
+            result.reserve(total);
+            for (auto &part : parts) {
+                std::move(part.begin(), part.end(), std::back_inserter(result));
+            }
+            return result;
+        }
+
+    private:
+        template <typename Stage>
+        auto then(Stage stage) {
+            using Next = detail::ComposedTail<Tail, Stage>;
+            return ParallelView<V, Next>(std::move(base), settings, Next{std::move(tail), std::move(stage)});
+        }
+
+        V base;
+        ParallelStage settings;
+        Tail tail;
+    };
+
+    template <std::ranges::viewable_range R>
+        requires std::ranges::input_range<R>
+    auto operator|(R &&range, ParallelStage stage) {
+        return ParallelView<std::views::all_t<R>>(std::views::all(std::forward<R>(range)), stage);
+    }
+
+} // namespace neko::ops::pipeline
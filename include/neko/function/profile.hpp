@@ -0,0 +1,263 @@
+/**
+ * @file profile.hpp
+ * @brief Opt-in profiling hooks for library hot paths
+ * @author moehoshio
+ * @copyright Copyright (c) 2025 Hoshi
+ * @license MIT OR Apache-2.0
+ *
+ * Hot paths in hash, pattern, detect and archive are instrumented with NEKO_FUNCTION_PROFILE_SCOPE.
+ * Without NEKO_FUNCTION_ENABLE_PROFILING the macros expand to nothing; with it, every instrumented
+ * call records its count, bytes and latency into a Probe, and is forwarded to the sink if one is set.
+ */
+
+#pragma once
+
+// Include header for non-module usage
+#if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#endif
+
+/**
+ * @namespace neko::util::profile
+ * @brief Call counters and latency histograms.
+ */
+namespace neko::util::profile {
+
+    /**
+     * @brief Number of latency buckets; bucket i counts calls taking [2^i, 2^(i+1)) nanoseconds.
+     * The last bucket also holds every slower call.
+     */
+    constexpr std::size_t histogramBuckets = 40;
+
+    /**
+     * @struct Event
+     * @brief One completed call of an instrumented function.
+     */
+    struct Event {
+        std::string_view name;              // Probe name, e.g. "hash.digestFile"
+        std::uint64_t bytes = 0;            // Bytes processed by the call, 0 if not applicable
+        std::chrono::nanoseconds elapsed{0};
+    };
+
+    /**
+     * @struct ProbeStats
+     * @brief Totals of one probe since it was created or last reset.
+     */
+    struct ProbeStats {
+        std::string_view name;
+        std::uint64_t calls = 0;
+        std::uint64_t bytes = 0;
+        std::chrono::nanoseconds total{0};
+        std::chrono::nanoseconds max{0};
+        std::array<std::uint64_t, histogramBuckets> histogram{};
+
+        std::chrono::nanoseconds mean() const noexcept {
+            return calls ? total / static_cast<std::int64_t>(calls) : std::chrono::nanoseconds{0};
+        }
+
+        /**
+         * @brief Upper bound of the bucket holding the given quantile, e.g. 0.99 for p99.
+         */
+        std::chrono::nanoseconds percentile(double quantile) const noexcept {
+            const auto target = static_cast<std::uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(calls));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < histogramBuckets; ++i) {
+                seen += histogram[i];
+                if (seen > 0 && seen >= target)
+                    return std::min(std::chrono::nanoseconds{std::int64_t{2} << i}, max);
+            }
+            return max;
+        }
+    };
+
+    /**
+     * @brief Receives every completed call while set; calls are serialized.
+     * Exceptions thrown by the sink are discarded.
+     */
+    using Sink = std::function<void(const Event &)>;
+
+    class Probe;
+
+    namespace detail {
+        struct Registry {
+            std::atomic<Probe *> head{nullptr};
+            std::atomic<bool> hasSink{false};
+            std::mutex sinkMutex;
+            Sink sink;
+        };
+
+        inline Registry &registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        constexpr std::size_t bucketOf(std::uint64_t nanoseconds) noexcept {
+            if (nanoseconds == 0)
+                return 0;
+            return std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(nanoseconds)) - 1, histogramBuckets - 1);
+        }
+    } // namespace detail
+
+    /**
+     * @class Probe
+     * @brief Lock-free counters for one instrumented site.
+     * Probes register themselves on construction and live for the rest of the program,
+     * so they are meant to be function-local statics.
+     */
+    class Probe {
+    public:
+        explicit Probe(std::string_view name) noexcept : probeName(name) {
+            auto &head = detail::registry().head;
+            next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+        Probe(const Probe &) = delete;
+        Probe &operator=(const Probe &) = delete;
+
+        void record(std::uint64_t bytes, std::chrono::nanoseconds elapsed) noexcept {
+            const auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(elapsed.count(), 0));
+            calls.fetch_add(1, std::memory_order_relaxed);
+            byteCount.fetch_add(bytes, std::memory_order_relaxed);
+            totalNs.fetch_add(ns, std::memory_order_relaxed);
+            histogram[detail::bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+            auto previous = maxNs.load(std::memory_order_relaxed);
+            while (previous < ns && !maxNs.compare_exchange_weak(previous, ns, std::memory_order_relaxed)) {
+            }
+
+            // Calls made by the sink itself are counted but not forwarded
+            thread_local bool inSink = false;
+            auto &registry = detail::registry();
+            if (!inSink && registry.hasSink.load(std::memory_order_acquire)) {
+                std::lock_guard<std::mutex> lock(registry.sinkMutex);
+                if (registry.sink) {
+                    inSink = true;
+                    try {
+                        registry.sink(Event{probeName, bytes, elapsed});
+                    } catch (...) {
+                    }
+                    inSink = false;
+                }
+            }
+        }
+
+        ProbeStats stats() const noexcept {
+            ProbeStats result;
+            result.name = probeName;
+            result.calls = calls.load(std::memory_order_relaxed);
+            result.bytes = byteCount.load(std::memory_order_relaxed);
+            result.total = std::chrono::nanoseconds{static_cast<std::int64_t>(totalNs.load(std::memory_order_relaxed))};
+            result.max = std::chrono::nanoseconds{static_cast<std::int64_t>(maxNs.load(std::memory_order_relaxed))};
+            for (std::size_t i = 0; i < histogramBuckets; ++i)
+                result.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+            return result;
+        }
+
+        void reset() noexcept {
+            calls.store(0, std::memory_order_relaxed);
+            byteCount.store(0, std::memory_order_relaxed);
+            totalNs.store(0, std::memory_order_relaxed);
+            maxNs.store(0, std::memory_order_relaxed);
+            for (auto &bucket : histogram)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+
+        std::string_view name() const noexcept {
+            return probeName;
+        }
+
+        Probe *nextProbe() const noexcept {
+            return next;
+        }
+
+    private:
+        std::string_view probeName;
+        std::atomic<std::uint64_t> calls{0}, byteCount{0}, totalNs{0}, maxNs{0};
+        std::array<std::atomic<std::uint64_t>, histogramBuckets> histogram{};
+        Probe *next = nullptr;
+    };
+
+    /**
+     * @class ScopedTimer
+     * @brief Records the lifetime of the scope, and the bytes added to it, into a probe.
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Probe &probe) noexcept
+            : probe(probe), begin(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() {
+            probe.record(bytes, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin));
+        }
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+        void addBytes(std::uint64_t count) noexcept {
+            bytes += count;
+        }
+
+    private:
+        Probe &probe;
+        std::uint64_t bytes = 0;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    /**
+     * @brief Sets the sink receiving every completed call. An empty function removes it.
+     */
+    inline void setSink(Sink sink) {
+        auto &registry = detail::registry();
+        std::lock_guard<std::mutex> lock(registry.sinkMutex);
+        registry.sink = std::move(sink);
+        registry.hasSink.store(static_cast<bool>(registry.sink), std::memory_order_release);
+    }
+
+    /**
+     * @brief Totals of every probe reached so far. Probes are created on the first call of their site.
+     */
+    inline std::vector<ProbeStats> snapshot() {
+        std::vector<ProbeStats> result;
+        for (const Probe *probe = detail::registry().head.load(std::memory_order_acquire); probe; probe = probe->nextProbe())
+            result.push_back(probe->stats());
+        std::sort(result.begin(), result.end(), [](const ProbeStats &a, const ProbeStats &b) {
+            return a.name < b.name;
+        });
+        return result;
+    }
+
+    /**
+     * @brief Clears the totals of every probe.
+     */
+    inline void reset() noexcept {
+        for (Probe *probe = detail::registry().head.load(std::memory_order_acquire); probe; probe = probe->nextProbe())
+            probe->reset();
+    }
+
+} // namespace neko::util::profile
+
+/**
+ * @def NEKO_FUNCTION_PROFILE_SCOPE(timer, name)
+ * @brief Times the rest of the enclosing scope under the probe name when NEKO_FUNCTION_ENABLE_PROFILING is defined.
+ * @def NEKO_FUNCTION_PROFILE_BYTES(timer, count)
+ * @brief Adds processed bytes to a timer declared by NEKO_FUNCTION_PROFILE_SCOPE.
+ */
+#if defined(NEKO_FUNCTION_ENABLE_PROFILING)
+#define NEKO_FUNCTION_PROFILE_SCOPE(timer, name)                  \
+    static ::neko::util::profile::Probe timer##Probe{name}; \
+    ::neko::util::profile::ScopedTimer timer { timer##Probe }
+#define NEKO_FUNCTION_PROFILE_BYTES(timer, count) timer.addBytes(static_cast<std::uint64_t>(count))
+#else
+#define NEKO_FUNCTION_PROFILE_SCOPE(timer, name) static_cast<void>(0)
+#define NEKO_FUNCTION_PROFILE_BYTES(timer, count) static_cast<void>(0)
+#endif
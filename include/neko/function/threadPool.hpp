@@ -0,0 +1,392 @@
+/**
+ * @file threadPool.hpp
+ * @brief Shared work-stealing thread pool
+ * @author moehoshio
+ * @copyright Copyright (c) 2025 Hoshi
+ * @license MIT OR Apache-2.0
+ */
+
+#pragma once
+
+// Include header for non-module usage
+#if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#endif
+
+/**
+ * @namespace neko::util::pool
+ * @brief The library-owned thread pool used by the parallel and async functions.
+ *
+ * Parallel functions (hash::digestFiles, detect::identifyFileTypes, zip extract/create with threads > 1,
+ * the parallel() pipeline stage) run their helpers on defaultPool() instead of starting threads, so several
+ * operations running at once share the same cores. The calling thread always works as well, and helpers
+ * still queued when the work is done are skipped; this keeps nested use from pool threads deadlock-free.
+ */
+namespace neko::util::pool {
+
+    /**
+     * @class ThreadPool
+     * @brief Fixed set of workers, each with its own deque; idle workers steal from the others.
+     *
+     * Jobs posted from a worker go to that worker's deque and are taken newest-first by it,
+     * oldest-first by thieves. Jobs posted from other threads are spread round-robin.
+     * The destructor runs the jobs still queued, then joins the workers.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @param threads Number of workers, 0 uses the hardware concurrency.
+         */
+        explicit ThreadPool(std::size_t threads = 0) {
+            if (threads == 0) {
+                threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+            }
+            queues.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i) {
+                queues.push_back(std::make_unique<Queue>());
+            }
+            workers.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i) {
+                workers.emplace_back([this, i] { run(i); });
+            }
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto &worker : workers) {
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        std::size_t size() const noexcept {
+            return workers.size();
+        }
+
+        /**
+         * @brief Whether the calling thread is one of this pool's workers.
+         */
+        bool isWorkerThread() const noexcept {
+            return currentPool == this;
+        }
+
+        /**
+         * @brief Queues a job without a result. Exceptions thrown by the job are discarded.
+         */
+        template <typename F>
+        void post(F &&fn) {
+            push(Job(std::forward<F>(fn)));
+        }
+
+        /**
+         * @brief Queues a job and returns a future for its result or exception.
+         */
+        template <typename F>
+        auto submit(F &&fn) -> std::future<std::invoke_result_t<std::decay_t<F> &>> {
+            using Result = std::invoke_result_t<std::decay_t<F> &>;
+            std::packaged_task<Result()> task(std::forward<F>(fn));
+            auto future = task.get_future();
+            push(Job(std::move(task)));
+            return future;
+        }
+
+        /**
+         * @brief Awaitable that resumes the awaiting coroutine on a pool worker.
+         * @code
+         * co_await neko::util::pool::defaultPool().schedule();
+         * auto digest = neko::util::hash::digestFile(path); // runs on the pool
+         * @endcode
+         */
+        auto schedule() noexcept {
+            struct Awaiter {
+                ThreadPool &pool;
+                bool await_ready() const noexcept {
+                    return false;
+                }
+                void await_suspend(std::coroutine_handle<> handle) {
+                    pool.post([handle] { handle.resume(); });
+                }
+                void await_resume() const noexcept {}
+            };
+            return Awaiter{*this};
+        }
+
+    private:
+        // Move-only type-erased job, so packaged_task can be queued
+        class Job {
+        public:
+            Job() = default;
+            template <typename F>
+            explicit Job(F &&fn) : impl(std::make_unique<Impl<std::decay_t<F>>>(std::forward<F>(fn))) {}
+
+            void operator()() {
+                impl->run();
+            }
+
+        private:
+            struct Base {
+                virtual ~Base() = default;
+                virtual void run() = 0;
+            };
+            template <typename F>
+            struct Impl : Base {
+                explicit Impl(F &&fn) : fn(std::move(fn)) {}
+                explicit Impl(const F &fn) : fn(fn) {}
+                void run() override {
+                    fn();
+                }
+                F fn;
+            };
+            std::unique_ptr<Base> impl;
+        };
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+
+        void push(Job job) {
+            std::size_t index = isWorkerThread() ? currentIndex : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            {
+                std::lock_guard<std::mutex> lock(queues[index]->mutex);
+                queues[index]->jobs.push_back(std::move(job));
+            }
+            pending.fetch_add(1, std::memory_order_release);
+            {
+                // Pairs with the predicate check in run(), so the wake-up cannot be lost
+                std::lock_guard<std::mutex> lock(sleepMutex);
+            }
+            wake.notify_one();
+        }
+
+        bool tryPop(std::size_t self, Job &job) {
+            {
+                std::lock_guard<std::mutex> lock(queues[self]->mutex);
+                if (!queues[self]->jobs.empty()) {
+                    job = std::move(queues[self]->jobs.back());
+                    queues[self]->jobs.pop_back();
+                    return true;
+                }
+            }
+            for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+                auto &victim = *queues[(self + offset) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.jobs.empty()) {
+                    job = std::move(victim.jobs.front());
+                    victim.jobs.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void run(std::size_t index) {
+            currentPool = this;
+            currentIndex = index;
+            while (true) {
+                Job job;
+                if (tryPop(index, job)) {
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    try {
+                        job();
+                    } catch (...) {
+                    }
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wake.wait(lock, [&] { return stopping || pending.load(std::memory_order_acquire) > 0; });
+                if (stopping && pending.load(std::memory_order_acquire) == 0) {
+                    return;
+                }
+            }
+        }
+
+        static inline thread_local const ThreadPool *currentPool = nullptr;
+        static inline thread_local std::size_t currentIndex = 0;
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+        std::atomic<std::size_t> pending{0};
+        std::atomic<std::size_t> nextQueue{0};
+        std::mutex sleepMutex;
+        std::condition_variable wake;
+        bool stopping = false;
+    };
+
+    namespace detail {
+        // Guarded by one mutex so a size set concurrently with the first defaultPool() is either used or reported as too late
+        struct DefaultPoolState {
+            std::mutex mutex;
+            std::size_t threads = 0;
+            bool created = false;
+        };
+
+        inline DefaultPoolState &defaultPoolState() {
+            static DefaultPoolState state;
+            return state;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Sets the number of workers of defaultPool(); only effective before its first use.
+     * @param threads Number of workers, 0 uses the hardware concurrency.
+     * @return False, leaving the size unchanged, if the default pool already exists.
+     */
+    inline bool setDefaultPoolSize(std::size_t threads) {
+        auto &state = detail::defaultPoolState();
+        std::lock_guard lock(state.mutex);
+        if (state.created) {
+            return false;
+        }
+        state.threads = threads;
+        return true;
+    }
+
+    /**
+     * @brief The pool shared by the library, created on first use.
+     */
+    inline ThreadPool &defaultPool() {
+        static ThreadPool pool([] {
+            auto &state = detail::defaultPoolState();
+            std::lock_guard lock(state.mutex);
+            state.created = true;
+            return state.threads;
+        }());
+        return pool;
+    }
+
+    /**
+     * @class TaskGroup
+     * @brief Helper jobs whose owner does not depend on them starting.
+     *
+     * wait() closes the group: jobs that have not started yet are skipped, started ones are waited for,
+     * and the first exception is rethrown. The owner must therefore be able to finish the work itself,
+     * e.g. by claiming items from the same counter as the helpers.
+     * Skipped jobs only touch the group's shared state, so references captured by the job stay safe.
+     */
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool &pool = defaultPool())
+            : pool(pool), state(std::make_shared<State>()) {}
+
+        ~TaskGroup() {
+            try {
+                wait();
+            } catch (...) {
+            }
+        }
+
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+
+        template <typename F>
+        void run(F &&fn) {
+            pool.post([state = state, fn = std::forward<F>(fn)]() mutable {
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (state->closed) {
+                        return;
+                    }
+                    ++state->started;
+                }
+                try {
+                    fn();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->error) {
+                        state->error = std::current_exception();
+                    }
+                }
+                std::lock_guard<std::mutex> lock(state->mutex);
+                ++state->finished;
+                state->done.notify_all();
+            });
+        }
+
+        /**
+         * @brief Skips the jobs that have not started, waits for the others, and rethrows the first exception.
+         */
+        void wait() {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->closed = true;
+            state->done.wait(lock, [&] { return state->finished == state->started; });
+            if (state->error) {
+                auto error = std::exchange(state->error, nullptr);
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+        struct State {
+            std::mutex mutex;
+            std::condition_variable done;
+            std::size_t started = 0;
+            std::size_t finished = 0;
+            bool closed = false;
+            std::exception_ptr error;
+        };
+
+        ThreadPool &pool;
+        std::shared_ptr<State> state;
+    };
+
+    /**
+     * @brief Runs fn(worker) on the calling thread (worker 0) and on up to workers - 1 pool threads.
+     * fn is expected to claim work from shared state until none is left; pool helpers that start
+     * after the calling thread finished are skipped. The first exception is rethrown.
+     * @param workers Maximum number of concurrent invocations, 0 uses the pool size + 1.
+     */
+    template <typename F>
+    void runWorkers(std::size_t workers, F &&fn, ThreadPool &pool = defaultPool()) {
+        if (workers == 0) {
+            workers = pool.size() + 1;
+        }
+        if (workers <= 1) {
+            fn(std::size_t{0});
+            return;
+        }
+        TaskGroup group(pool);
+        for (std::size_t i = 1; i < workers; ++i) {
+            group.run([&fn, i] { fn(i); });
+        }
+        std::exception_ptr error;
+        try {
+            fn(std::size_t{0});
+        } catch (...) {
+            error = std::current_exception();
+        }
+        try {
+            group.wait();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+} // namespace neko::util::pool
@@ -19,23 +19,47 @@
 // Include header for non-module usage
 #if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
 
+#include <neko/function/base64.hpp>
+#include <neko/schema/exception.hpp>
+
 // C++ Standard Library
 #include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <initializer_list>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <random>
 #include <regex>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <bcrypt.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <sys/random.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#include <cstdlib>
+#endif
+
 #endif // NEKO_FUNCTION_ENABLE_MODULE
 /**
  * @namespace neko::ops
@@ -218,38 +242,96 @@ namespace neko::util {
             return upperStr;
         }
 
+        /**
+         * @brief Converts an ASCII letter to lowercase; other characters are returned unchanged.
+         * Unlike std::tolower, the result does not depend on the current locale.
+         */
+        constexpr char toLowerAscii(char ch) noexcept {
+            return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+        }
+
+        /**
+         * @brief Converts an ASCII letter to uppercase; other characters are returned unchanged.
+         */
+        constexpr char toUpperAscii(char ch) noexcept {
+            return (ch >= 'a' && ch <= 'z') ? static_cast<char>(ch - 'a' + 'A') : ch;
+        }
+
+        /**
+         * @brief Returns an ASCII-lowercased copy of a string.
+         */
+        inline std::string toLowerAscii(std::string_view str) {
+            std::string result(str);
+            for (auto &ch : result)
+                ch = toLowerAscii(ch);
+            return result;
+        }
+
+        /**
+         * @brief Returns an ASCII-uppercased copy of a string.
+         */
+        inline std::string toUpperAscii(std::string_view str) {
+            std::string result(str);
+            for (auto &ch : result)
+                ch = toUpperAscii(ch);
+            return result;
+        }
+
+        /**
+         * @brief Compares two strings, ignoring ASCII case.
+         */
+        constexpr bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept {
+            if (a.size() != b.size())
+                return false;
+            for (std::size_t i = 0; i < a.size(); ++i) {
+                if (toLowerAscii(a[i]) != toLowerAscii(b[i]))
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Gets the extension of the last path component, without the dot and without copying.
+         * Follows std::filesystem::path::extension(): a leading dot (".bashrc") does not start an extension,
+         * and dots in directory names are ignored.
+         * @param name File name or path. e.g. "/path/to/file.txt"
+         * @return View of the extension inside name (e.g. "txt"), empty if there is none
+         */
+        constexpr std::string_view getExtensionView(std::string_view name) noexcept {
+#if defined(_WIN32)
+            auto slash = name.find_last_of("/\\");
+#else
+            auto slash = name.find_last_of('/');
+#endif
+            std::string_view filename = slash == std::string_view::npos ? name : name.substr(slash + 1);
+            if (filename == "..")
+                return {};
+            auto pos = filename.rfind('.');
+            return (pos == std::string_view::npos || pos == 0) ? std::string_view{} : filename.substr(pos + 1);
+        }
+
         /**
          * @brief Gets the file extension from a filename.
          * @param filename Name of the file
          * @param caseSensitive Whether to convert the result to all lowercase
          * @return File extension (e.g. "txt")
+         * @see getExtensionView for the allocation-free version.
          */
-        inline std::string getExtensionName(const std::string &filename, bool caseSensitive = false) {
-            auto pos = filename.find_last_of('.');
-            if (pos == std::string::npos)
-                return "";
-            std::string ext = filename.substr(pos + 1);
-            if (!caseSensitive) {
-                ext = toLower(ext);
-            }
-            return ext;
+        inline std::string getExtensionName(std::string_view filename, bool caseSensitive = false) {
+            std::string_view ext = getExtensionView(filename);
+            return caseSensitive ? std::string(ext) : toLowerAscii(ext);
         }
 
         /**
-         * @brief Checks if a file has a specific extension.
+         * @brief Checks if a file has a specific extension, without allocating.
          * @param name Name to check. e.g. "/path/to/file.txt"
          * @param targetExtension Extension to match. e.g. "txt"
          * @param caseSensitive Whether to perform case-sensitive matching
          * @return true if the file has the specified extension, false otherwise
          */
-        inline bool matchExtensionName(std::string_view name, std::string_view targetExtension, bool caseSensitive = false) {
-            std::string ext = getExtensionName(std::string(name), caseSensitive);
-            std::string target(targetExtension);
-            if (!caseSensitive) {
-                ext = toLower(ext);
-                target = toLower(target);
-            }
-            return ext == target;
+        constexpr bool matchExtensionName(std::string_view name, std::string_view targetExtension, bool caseSensitive = false) noexcept {
+            std::string_view ext = getExtensionView(name);
+            return caseSensitive ? ext == targetExtension : equalsIgnoreCase(ext, targetExtension);
         }
 
         /**
@@ -257,16 +339,105 @@ namespace neko::util {
          * @param name Name to check. e.g. "/path/to/file.txt"
          * @param targetExtensions Vector of extensions to match. e.g. {"txt", "md", "docx"}
          * @return true if the file has any of the specified extensions, false otherwise
+         * @note For repeated checks against the same list, build an ExtensionSet once instead.
          */
-        inline bool matchExtensionNames(const std::string &name, const std::vector<std::string> &targetExtensions, bool caseSensitive = false) {
+        inline bool matchExtensionNames(std::string_view name, const std::vector<std::string> &targetExtensions, bool caseSensitive = false) {
+            std::string_view ext = getExtensionView(name);
             for (const auto &it : targetExtensions) {
-                if (matchExtensionName(name, it, caseSensitive)) {
+                if (caseSensitive ? ext == it : equalsIgnoreCase(ext, it)) {
                     return true;
                 }
             }
             return false;
         }
 
+        /**
+         * @class ExtensionSet
+         * @brief A set of extensions built once and checked in O(1) without allocating.
+         *
+         * Extensions may be given with or without the leading dot ("txt" or ".txt"); empty ones are ignored.
+         * Unless caseSensitive is set, lookups ignore ASCII case.
+         * @code
+         * const ExtensionSet images({"png", "jpg", "jpeg"});
+         * if (images.matches("textures/Stone.PNG")) { ... }
+         * @endcode
+         */
+        class ExtensionSet {
+        public:
+            explicit ExtensionSet(bool caseSensitive = false)
+                : set(0, Hash{caseSensitive}, Equal{caseSensitive}) {}
+
+            ExtensionSet(std::initializer_list<std::string_view> extensions, bool caseSensitive = false)
+                : ExtensionSet(caseSensitive) {
+                for (auto ext : extensions)
+                    insert(ext);
+            }
+
+            explicit ExtensionSet(const std::vector<std::string> &extensions, bool caseSensitive = false)
+                : ExtensionSet(caseSensitive) {
+                for (const auto &ext : extensions)
+                    insert(ext);
+            }
+
+            /**
+             * @brief Adds an extension, e.g. "txt" or ".txt".
+             */
+            void insert(std::string_view extension) {
+                if (!extension.empty() && extension.front() == '.')
+                    extension.remove_prefix(1);
+                if (!extension.empty())
+                    set.emplace(extension);
+            }
+
+            /**
+             * @brief Checks whether the extension, given without the dot (e.g. "txt"), is in the set.
+             */
+            bool contains(std::string_view extension) const {
+                return !extension.empty() && set.find(extension) != set.end();
+            }
+
+            /**
+             * @brief Checks whether the extension of a file name or path is in the set.
+             * @param name e.g. "/path/to/file.txt"
+             */
+            bool matches(std::string_view name) const {
+                return contains(getExtensionView(name));
+            }
+
+            bool empty() const noexcept {
+                return set.empty();
+            }
+
+            std::size_t size() const noexcept {
+                return set.size();
+            }
+
+        private:
+            // FNV-1a over the (optionally lowercased) bytes, so "PNG" and "png" share a bucket when case is ignored
+            struct Hash {
+                using is_transparent = void;
+                bool caseSensitive = false;
+                std::size_t operator()(std::string_view str) const noexcept {
+                    std::uint64_t hash = 14695981039346656037ull;
+                    for (char ch : str) {
+                        hash ^= static_cast<unsigned char>(caseSensitive ? ch : toLowerAscii(ch));
+                        hash *= 1099511628211ull;
+                    }
+                    return static_cast<std::size_t>(hash);
+                }
+            };
+
+            struct Equal {
+                using is_transparent = void;
+                bool caseSensitive = false;
+                bool operator()(std::string_view a, std::string_view b) const noexcept {
+                    return caseSensitive ? a == b : equalsIgnoreCase(a, b);
+                }
+            };
+
+            std::unordered_set<std::string, Hash, Equal> set;
+        };
+
         /**
          * @brief Normalizes path separators to forward slashes.
          * @tparam T String type
@@ -504,12 +675,210 @@ namespace neko::util {
             return std::nullopt;
         }
 
+        /**
+         * @brief A UTC point in time with nanosecond precision.
+         */
+        using UtcTime = std::chrono::sys_time<std::chrono::nanoseconds>;
+
+        /**
+         * @brief Longest output of formatIso8601: "YYYY-MM-DDTHH:MM:SS.fffffffffZ".
+         */
+        inline constexpr std::size_t iso8601MaxSize = 30;
+
+        namespace detail {
+            constexpr bool parseDigits(std::string_view text, std::size_t pos, std::size_t count, int &value) noexcept {
+                if (pos + count > text.size())
+                    return false;
+                value = 0;
+                for (std::size_t i = pos; i < pos + count; ++i) {
+                    if (text[i] < '0' || text[i] > '9')
+                        return false;
+                    value = value * 10 + (text[i] - '0');
+                }
+                return true;
+            }
+
+            constexpr void writeDigits(char *out, unsigned value, std::size_t count) noexcept {
+                for (std::size_t i = count; i > 0; --i) {
+                    out[i - 1] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                }
+            }
+
+            // Earliest and latest instants whose year strftime and formatIso8601 both print as four digits
+            inline constexpr std::chrono::sys_seconds fourDigitYearBegin{std::chrono::sys_days{std::chrono::year{1000} / 1 / 1}};
+            inline constexpr std::chrono::sys_seconds fourDigitYearEnd{std::chrono::sys_days{std::chrono::year{10000} / 1 / 1}};
+
+            // Whole years UtcTime can hold
+            inline constexpr std::chrono::sys_seconds utcTimeBegin{std::chrono::sys_days{std::chrono::year{1678} / 1 / 1}};
+            inline constexpr std::chrono::sys_seconds utcTimeEnd{std::chrono::sys_days{std::chrono::year{2262} / 1 / 1}};
+
+            /**
+             * @brief Splits an ISO 8601 timestamp into whole UTC seconds and the fraction.
+             * @return false if the text is not in the accepted format
+             */
+            constexpr bool parseIso8601(std::string_view text, std::chrono::sys_seconds &time, std::chrono::nanoseconds &fraction) noexcept {
+                using namespace std::chrono;
+                int year = 0, mon = 0, day = 0, hour = 0, min = 0, sec = 0;
+                if (text.size() < 19 || !parseDigits(text, 0, 4, year) || text[4] != '-' || !parseDigits(text, 5, 2, mon) || text[7] != '-' ||
+                    !parseDigits(text, 8, 2, day) || (text[10] != 'T' && text[10] != 't') || !parseDigits(text, 11, 2, hour) ||
+                    text[13] != ':' || !parseDigits(text, 14, 2, min) || text[16] != ':' || !parseDigits(text, 17, 2, sec)) {
+                    return false;
+                }
+
+                std::size_t pos = 19;
+                std::int64_t nanos = 0;
+                if (pos < text.size() && text[pos] == '.') {
+                    const std::size_t begin = ++pos;
+                    for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++pos) {
+                        if (pos - begin < 9)
+                            nanos = nanos * 10 + (text[pos] - '0');
+                    }
+                    if (pos == begin)
+                        return false;
+                    for (std::size_t digits = pos - begin; digits < 9; ++digits)
+                        nanos *= 10;
+                }
+
+                int offset = 0;
+                if (pos < text.size() && text[pos] == 'Z') {
+                    ++pos;
+                } else if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+                    const int sign = text[pos] == '+' ? 1 : -1;
+                    int offsetHour = 0, offsetMin = 0;
+                    if (!parseDigits(text, pos + 1, 2, offsetHour))
+                        return false;
+                    pos += 3;
+                    if (pos < text.size() && text[pos] == ':')
+                        ++pos;
+                    if (!parseDigits(text, pos, 2, offsetMin))
+                        return false;
+                    pos += 2;
+                    offset = sign * (offsetHour * 3600 + offsetMin * 60);
+                }
+                if (pos != text.size())
+                    return false;
+
+                // Month 00 and 13+ roll over into the neighbouring years, as timegm does
+                const int months = year * 12 + mon - 1;
+                const int y = months >= 0 ? months / 12 : -1;
+                const sys_days date = sys_days{std::chrono::year{y} / (months - y * 12 + 1) / 1} + days{day - 1};
+                time = sys_seconds{date} + hours{hour} + minutes{min} + seconds{sec - offset};
+                fraction = nanoseconds{nanos};
+                return true;
+            }
+        } // namespace detail
+
+        /**
+         * @brief Parses an ISO 8601 timestamp without regex or allocation.
+         *
+         * Accepts "YYYY-MM-DDTHH:MM:SS" (or a lowercase 't'), optional fractional seconds of any length, and an optional
+         * "Z", "+hh:mm" or "+hhmm" suffix; no suffix means UTC. Out-of-range fields are normalized like timegm, so
+         * "2024-01-32" is February 1st. Digits beyond nanoseconds are truncated.
+         * @param text ISO 8601 formatted string
+         * @return The UTC time, or std::nullopt if the text is not in this format or falls outside the years 1678-2261
+         */
+        constexpr std::optional<UtcTime> parseIso8601(std::string_view text) noexcept {
+            std::chrono::sys_seconds time{};
+            std::chrono::nanoseconds fraction{};
+            if (!detail::parseIso8601(text, time, fraction) || time < detail::utcTimeBegin || time >= detail::utcTimeEnd)
+                return std::nullopt;
+            return UtcTime{time} + fraction;
+        }
+
+        /**
+         * @brief Parses many ISO 8601 timestamps.
+         * @return One result per input, in order
+         */
+        inline std::vector<std::optional<UtcTime>> parseIso8601(std::span<const std::string_view> texts) {
+            std::vector<std::optional<UtcTime>> results;
+            results.reserve(texts.size());
+            for (std::string_view text : texts)
+                results.push_back(parseIso8601(text));
+            return results;
+        }
+
+        inline std::vector<std::optional<UtcTime>> parseIso8601(std::span<const std::string> texts) {
+            std::vector<std::optional<UtcTime>> results;
+            results.reserve(texts.size());
+            for (const std::string &text : texts)
+                results.push_back(parseIso8601(text));
+            return results;
+        }
+
+        /**
+         * @brief Formats a UTC time as "YYYY-MM-DDTHH:MM:SS[.f...]Z" into a caller-provided buffer, without strftime.
+         * @param time UTC time to format
+         * @param output Destination, iso8601MaxSize characters always suffice
+         * @param fractionDigits Digits of fractional seconds to write, 0 to 9; extra precision is truncated
+         * @return The number of characters written, or 0 if the year is outside 0000-9999
+         * @throws ex::InvalidArgument if fractionDigits is out of range or the output buffer is too small
+         */
+        template <typename Duration>
+        std::size_t formatIso8601(std::chrono::sys_time<Duration> time, std::span<char> output, int fractionDigits = 0) {
+            using namespace std::chrono;
+            if (fractionDigits < 0 || fractionDigits > 9)
+                throw ex::InvalidArgument("fractionDigits must be between 0 and 9");
+            const std::size_t size = 20 + (fractionDigits > 0 ? fractionDigits + 1 : 0);
+            if (output.size() < size)
+                throw ex::InvalidArgument("ISO 8601 output buffer too small");
+
+            const sys_days date = floor<days>(time);
+            const year_month_day ymd{date};
+            if (ymd.year() < std::chrono::year{0} || ymd.year() > std::chrono::year{9999})
+                return 0;
+            const hh_mm_ss tod{time - date};
+
+            char *out = output.data();
+            detail::writeDigits(out, static_cast<unsigned>(static_cast<int>(ymd.year())), 4);
+            out[4] = '-';
+            detail::writeDigits(out + 5, static_cast<unsigned>(ymd.month()), 2);
+            out[7] = '-';
+            detail::writeDigits(out + 8, static_cast<unsigned>(ymd.day()), 2);
+            out[10] = 'T';
+            detail::writeDigits(out + 11, static_cast<unsigned>(tod.hours().count()), 2);
+            out[13] = ':';
+            detail::writeDigits(out + 14, static_cast<unsigned>(tod.minutes().count()), 2);
+            out[16] = ':';
+            detail::writeDigits(out + 17, static_cast<unsigned>(tod.seconds().count()), 2);
+            std::size_t pos = 19;
+            if (fractionDigits > 0) {
+                out[pos++] = '.';
+                auto fraction = static_cast<unsigned>(duration_cast<nanoseconds>(tod.subseconds()).count());
+                for (int i = fractionDigits; i < 9; ++i)
+                    fraction /= 10;
+                detail::writeDigits(out + pos, fraction, static_cast<std::size_t>(fractionDigits));
+                pos += static_cast<std::size_t>(fractionDigits);
+            }
+            out[pos++] = 'Z';
+            return pos;
+        }
+
+        /**
+         * @brief Formats a UTC time as "YYYY-MM-DDTHH:MM:SS[.f...]Z".
+         * @return The formatted time, or std::nullopt if the year is outside 0000-9999
+         * @throws ex::InvalidArgument if fractionDigits is out of range
+         */
+        template <typename Duration>
+        std::optional<std::string> formatIso8601(std::chrono::sys_time<Duration> time, int fractionDigits = 0) {
+            std::array<char, iso8601MaxSize> buffer{};
+            const std::size_t size = formatIso8601(time, buffer, fractionDigits);
+            if (size == 0)
+                return std::nullopt;
+            return std::string(buffer.data(), size);
+        }
+
         /**
          * @brief Formats the current time as an ISO 8601 string in UTCZ.
          * @param utcT Utc timestamp to format, defaults to current time
          * @return Formatted time string in ISO 8601 format (e.g., "2024-06-07T15:04:05Z")
          */
         inline std::optional<std::string> getUtcZTimeString(std::time_t utcT = getUtcNow()) {
+            const std::chrono::sys_seconds seconds{std::chrono::seconds{utcT}};
+            if (seconds >= detail::fourDigitYearBegin && seconds < detail::fourDigitYearEnd) {
+                return formatIso8601(seconds);
+            }
+
             std::tm tmResult = toUtcTm(utcT);
 
             std::array<char, 128> timeString{};
@@ -523,45 +892,15 @@ namespace neko::util {
          * @brief Parses an ISO 8601 formatted string (e.g., "2024-06-07T15:04:05Z") to std::tm (UTC).
          * @param iso8601 ISO 8601 formatted string. format: "YYYY-MM-DDTHH:MM:SSZ" or "YYYY-MM-DDTHH:MM:SS+hh:mm" (included +hhmm/-hhmm)
          * @return std::optional<std::tm> Parsed UTC time structure, std::nullopt if parsing fails
+         * @see parseIso8601 to keep fractional seconds
          */
-        inline std::optional<std::time_t> parseToUTCTime(const std::string &iso8601) {
-            std::tm tmResult = {};
-            std::regex r(R"((\d{4})-(\d{2})-(\d{2})[Tt](\d{2}):(\d{2}):(\d{2})(?:\.\d+)?(Z|([+-])(\d{2}):?(\d{2}))?)");
-            std::smatch m;
-
-            if (!std::regex_match(iso8601, m, r) || m.size() < 7) {
+        inline std::optional<std::time_t> parseToUTCTime(std::string_view iso8601) {
+            std::chrono::sys_seconds time{};
+            std::chrono::nanoseconds fraction{};
+            if (!detail::parseIso8601(iso8601, time, fraction)) {
                 return std::nullopt;
             }
-
-            // At least require <YYYY>-<MM>-<DD>T/t<HH>:<MM>:<SS>Z = size 6(+1)
-            tmResult.tm_year = std::stoi(m[1]) - 1900;
-            tmResult.tm_mon = std::stoi(m[2]) - 1;
-            tmResult.tm_mday = std::stoi(m[3]);
-            tmResult.tm_hour = std::stoi(m[4]);
-            tmResult.tm_min = std::stoi(m[5]);
-            tmResult.tm_sec = std::stoi(m[6]);
-            tmResult.tm_isdst = 0;
-
-            // Zero timezone offset
-            if (!m[7].matched || (m[7].matched && m[7] == "Z")) {
-                return toUtcTimeT(tmResult);
-            }
-
-            // <YYYY>-<MM>-<DD>T/t<HH>:<MM>:<SS><+><hh>:<mm> = size 10(+1)
-            if (m[8].matched && m[9].matched && m[10].matched) {
-                int sign = (m[8] == "+") ? 1 : -1;
-                int offset_hour = std::stoi(m[9]);
-                int offset_min = std::stoi(m[10]);
-                int offset_sec = sign * (offset_hour * 3600 + offset_min * 60);
-
-                std::time_t t = toUtcTimeT(tmResult);
-                // Subtract the timezone offset to get UTC time
-                t -= offset_sec;
-                tmResult = toUtcTm(t);
-                return toUtcTimeT(tmResult);
-            }
-
-            return std::nullopt; // Unable to parse timezone offset
+            return static_cast<std::time_t>(time.time_since_epoch().count());
         }
 
         /**
@@ -569,7 +908,7 @@ namespace neko::util {
          * @param iso8601 ISO 8601 formatted string. format: "YYYY-MM-DDTHH:MM:SSZ" or "YYYY-MM-DDTHH:MM:SS+hh:mm" (included +hhmm/-hhmm)
          * @return std::optional<std::string> Parsed UTC 0 time string, std::nullopt if parsing fails
          */
-        inline std::optional<std::string> parseToUTCTimeString(const std::string &iso8601) {
+        inline std::optional<std::string> parseToUTCTimeString(std::string_view iso8601) {
             auto utcTime = parseToUTCTime(iso8601);
             if (!utcTime) {
                 return std::nullopt;
@@ -582,7 +921,7 @@ namespace neko::util {
          * @param iso8601 ISO 8601 formatted string. format: "YYYY-MM-DDTHH:MM:SSZ" or "YYYY-MM-DDTHH:MM:SS+hh:mm" (included +hhmm/-hhmm)
          * @return std::optional<std::string> Parsed local time string, std::nullopt if parsing fails
          */
-        inline std::optional<std::string> parseToLocalTimeString(const std::string &iso8601) {
+        inline std::optional<std::string> parseToLocalTimeString(std::string_view iso8601) {
             auto utcTime = parseToUTCTime(iso8601);
             if (!utcTime) {
                 return std::nullopt;
@@ -592,128 +931,312 @@ namespace neko::util {
     } // namespace time
 
     /**
-     * @namespace neko::util::base64
-     * @brief Base64 encoding and decoding utilities.
+     * @namespace neko::util::random
+     * @brief Random value generation utilities.
      */
-    namespace base64 {
+    namespace random {
+
         /**
-         * @brief Characters used for Base64 encoding.
+         * @brief xoshiro256** generator (Blackman and Vigna), a UniformRandomBitGenerator.
+         * 32 bytes of state, fast, and good enough for identifiers and sampling; not for secrets.
          */
-        constexpr std::string_view base64Chars =
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-            "abcdefghijklmnopqrstuvwxyz"
-            "0123456789+/";
+        class Xoshiro256 {
+        public:
+            using result_type = std::uint64_t;
+
+            /**
+             * @brief Seeds the state by expanding seed with SplitMix64, as the authors recommend.
+             */
+            constexpr explicit Xoshiro256(std::uint64_t seed) noexcept {
+                for (auto &word : state) {
+                    seed += 0x9E3779B97F4A7C15ull;
+                    std::uint64_t z = seed;
+                    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                    word = z ^ (z >> 31);
+                }
+            }
+
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+            constexpr result_type operator()() noexcept {
+                const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+                const std::uint64_t t = state[1] << 17;
+                state[2] ^= state[0];
+                state[3] ^= state[1];
+                state[1] ^= state[2];
+                state[0] ^= state[3];
+                state[2] ^= t;
+                state[3] = rotl(state[3], 45);
+                return result;
+            }
+
+        private:
+            static constexpr std::uint64_t rotl(std::uint64_t x, int k) noexcept {
+                return (x << k) | (x >> (64 - k));
+            }
+
+            std::array<std::uint64_t, 4> state{};
+        };
 
         /**
-         * @brief Encodes a string using Base64.
-         * @param input String to encode
-         * @return Base64 encoded string
+         * @brief Cryptographically secure 64-bit source, a UniformRandomBitGenerator.
+         * Backed by the operating system: BCryptGenRandom on Windows, getrandom on Linux, arc4random_buf on
+         * Apple and BSD systems. The choice depends only on the target platform, so every translation unit of
+         * a program uses the same source whatever library options it was compiled with.
+         * @note On other platforms std::random_device is used, which is only as strong as the standard library
+         * makes it: the standard allows a deterministic engine when no non-deterministic source is available.
+         * Bytes are fetched in blocks to amortize the system call.
          */
-        inline std::string base64Encode(const std::string &input) {
-            std::string encodedString;
-            int val = 0;
-            int bits = -6;
-            const unsigned int b63 = 0x3F;
+        class SecureRandom {
+        public:
+            using result_type = std::uint64_t;
 
-            for (unsigned char c : input) {
-                val = (val << 8) + c;
-                bits += 8;
-                while (bits >= 0) {
-                    encodedString.push_back(base64Chars[(val >> bits) & b63]);
-                    bits -= 6;
-                }
+            static constexpr result_type min() noexcept { return 0; }
+            static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+            result_type operator()() {
+                if (next == block.size())
+                    refill();
+                return block[next++];
             }
 
-            if (bits > -6) {
-                encodedString.push_back(base64Chars[((val << 8) >> (bits + 8)) & b63]);
+            /**
+             * @brief Fills out with secure random bytes without going through the block.
+             * @throws ex::Runtime if the system source fails
+             */
+            static void fill(std::span<std::byte> out) {
+#if defined(_WIN32)
+                for (std::size_t pos = 0; pos < out.size();) {
+                    const auto n = static_cast<ULONG>(std::min<std::size_t>(out.size() - pos, std::numeric_limits<ULONG>::max()));
+                    if (!BCRYPT_SUCCESS(::BCryptGenRandom(nullptr, reinterpret_cast<PUCHAR>(out.data() + pos), n, BCRYPT_USE_SYSTEM_PREFERRED_RNG)))
+                        throw ex::Runtime("BCryptGenRandom failed");
+                    pos += n;
+                }
+#elif defined(__linux__)
+                for (std::size_t pos = 0; pos < out.size();) {
+                    const auto got = ::getrandom(out.data() + pos, out.size() - pos, 0);
+                    if (got < 0) {
+                        if (errno == EINTR)
+                            continue;
+                        throw ex::Runtime("getrandom failed");
+                    }
+                    pos += static_cast<std::size_t>(got);
+                }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+                ::arc4random_buf(out.data(), out.size());
+#else
+                static thread_local std::random_device device;
+                for (std::size_t pos = 0; pos < out.size();) {
+                    const auto word = static_cast<std::uint32_t>(device());
+                    const std::size_t n = std::min<std::size_t>(out.size() - pos, sizeof(word));
+                    std::memcpy(out.data() + pos, &word, n);
+                    pos += n;
+                }
+#endif
             }
 
-            while (encodedString.size() % 4) {
-                encodedString.push_back('=');
+        private:
+            void refill() {
+                fill(std::as_writable_bytes(std::span(block)));
+                next = 0;
             }
 
-            return encodedString;
+            std::array<std::uint64_t, 32> block{};
+            std::size_t next = block.size();
+        };
+
+        /**
+         * @brief Where random values come from.
+         */
+        enum class Source {
+            fast,  ///< The thread-local Xoshiro256 engine
+            secure ///< The thread-local SecureRandom source, for tokens, nonces and keys
+        };
+
+        /**
+         * @brief The thread-local fast engine, seeded once per thread from std::random_device.
+         */
+        inline Xoshiro256 &engine() {
+            static thread_local Xoshiro256 gen{(std::uint64_t(std::random_device{}()) << 32) ^ std::random_device{}()};
+            return gen;
         }
 
         /**
-         * @brief Decodes a Base64 encoded string.
-         * @param input Base64 encoded string
-         * @return Decoded string
+         * @brief The thread-local secure source.
          */
-        inline std::string base64Decode(const std::string &input) {
-            std::string decodedString;
-            std::vector<int> base64Index(256, -1);
-            for (int i = 0; i < 64; i++) {
-                base64Index[base64Chars[i]] = i;
+        inline SecureRandom &secureEngine() {
+            static thread_local SecureRandom gen;
+            return gen;
+        }
+
+        namespace detail {
+            inline std::uint64_t mulHigh(std::uint64_t a, std::uint64_t b, std::uint64_t &low) noexcept {
+#if defined(__SIZEOF_INT128__)
+                const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+                low = static_cast<std::uint64_t>(product);
+                return static_cast<std::uint64_t>(product >> 64);
+#else
+                const std::uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32, bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+                const std::uint64_t ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+                const std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+                low = (mid << 32) | (ll & 0xFFFFFFFF);
+                return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+            }
+
+            inline constexpr std::array<std::uint64_t, 20> powersOf10 = [] {
+                std::array<std::uint64_t, 20> table{};
+                std::uint64_t value = 1;
+                for (auto &p : table) {
+                    p = value;
+                    value *= 10;
+                }
+                return table;
+            }();
+
+            template <typename Generator>
+            void fillBytes(Generator &gen, std::span<std::byte> out) {
+                std::size_t pos = 0;
+                for (; pos + 8 <= out.size(); pos += 8) {
+                    const std::uint64_t word = gen();
+                    std::memcpy(out.data() + pos, &word, 8);
+                }
+                if (pos < out.size()) {
+                    const std::uint64_t word = gen();
+                    std::memcpy(out.data() + pos, &word, out.size() - pos);
+                }
             }
+        } // namespace detail
 
-            int val = 0;
-            int bits = -8;
-            for (unsigned char c : input) {
-                if (base64Index[c] == -1)
-                    break;
-                val = (val << 6) + base64Index[c];
-                bits += 6;
+        /**
+         * @brief Draws an integer in [0, bound) without modulo bias (Lemire's multiply-and-reject).
+         * @param bound Exclusive upper bound, must not be 0
+         */
+        template <typename Generator>
+        std::uint64_t uniform(Generator &gen, std::uint64_t bound) {
+            std::uint64_t low = 0;
+            std::uint64_t high = detail::mulHigh(gen(), bound, low);
+            if (low < bound) {
+                const std::uint64_t threshold = (0 - bound) % bound;
+                while (low < threshold)
+                    high = detail::mulHigh(gen(), bound, low);
+            }
+            return high;
+        }
 
-                if (bits >= 0) {
-                    decodedString.push_back(char((val >> bits) & 0xFF));
-                    bits -= 8;
+        /**
+         * @brief Fills out with characters drawn uniformly from characters.
+         *
+         * Each 64-bit draw is reduced without bias to a number below k^m, where k is the alphabet size and m the
+         * most characters that fit, and yields m characters: 10 for the 62-character alphanumeric set, 15 for hex.
+         * @throws std::invalid_argument if characters is empty
+         */
+        template <typename Generator>
+        void fillChars(Generator &gen, std::span<char> out, std::string_view characters) {
+            if (characters.empty()) {
+                throw std::invalid_argument("characters list must not be empty");
+            }
+            const std::uint64_t k = characters.size();
+            if (k == 1) {
+                std::fill(out.begin(), out.end(), characters[0]);
+                return;
+            }
+            std::uint64_t range = k;
+            std::size_t perDraw = 1;
+            while (range <= std::numeric_limits<std::uint64_t>::max() / k) {
+                range *= k;
+                ++perDraw;
+            }
+            for (std::size_t pos = 0; pos < out.size();) {
+                std::uint64_t value = uniform(gen, range);
+                for (std::size_t i = 0; i < perDraw && pos < out.size(); ++i, ++pos) {
+                    out[pos] = characters[value % k];
+                    value /= k;
                 }
             }
+        }
 
-            return decodedString;
+        /**
+         * @brief Fills out with random bytes.
+         * @throws ex::Runtime if the secure source fails
+         */
+        inline void fill(std::span<std::byte> out, Source source = Source::fast) {
+            if (source == Source::secure)
+                SecureRandom::fill(out);
+            else
+                detail::fillBytes(engine(), out);
+        }
+
+        /**
+         * @brief Fills out with random 64-bit values.
+         */
+        inline void fill(std::span<std::uint64_t> out, Source source = Source::fast) {
+            if (source == Source::secure) {
+                SecureRandom::fill(std::as_writable_bytes(out));
+                return;
+            }
+            Xoshiro256 &gen = engine();
+            for (auto &value : out)
+                value = gen();
+        }
+
+        /**
+         * @brief Draws an integer in [0, bound) without modulo bias.
+         */
+        inline std::uint64_t uniform(std::uint64_t bound, Source source = Source::fast) {
+            return source == Source::secure ? uniform(secureEngine(), bound) : uniform(engine(), bound);
         }
-    } // namespace base64
 
-    /**
-     * @namespace neko::util::random
-     * @brief Random value generation utilities.
-     */
-    namespace random {
         /**
          * @brief Generates a random hexadecimal string.
          * @param digits Number of hexadecimal digits to generate
+         * @param source Source of randomness, Source::secure for tokens
          * @return Random hexadecimal string
          */
-        inline std::string randomHex(int digits = 16) {
-            static thread_local std::mt19937 gen{std::random_device{}()};
-            static thread_local std::uniform_int_distribution<> dis(0, 15);
-            const char *hex_chars = "0123456789abcdef";
-            std::string result;
-            result.reserve(digits);
-            for (int i = 0; i < digits; ++i)
-                result += hex_chars[dis(gen)];
+        inline std::string randomHex(int digits = 16, Source source = Source::fast) {
+            std::string result(static_cast<std::size_t>(std::max(digits, 0)), '\0');
+            if (source == Source::secure)
+                fillChars(secureEngine(), result, "0123456789abcdef");
+            else
+                fillChars(engine(), result, "0123456789abcdef");
             return result;
         }
 
         /**
          * @brief Generates a random number with a specified number of digits.
+         * The digit count is drawn uniformly first, then the number uniformly among numbers of that length.
          * @param minimumDigits Minimum number of digits (default: 1)
          * @param maximumDigits Maximum number of digits (default: 10)
          * @return Random number
+         * @throw std::invalid_argument unless 1 <= minimumDigits <= maximumDigits <= 20
          */
         inline uint64_t randomNDigitNumber(int minimumDigits = 1, int maximumDigits = 10) {
-            static thread_local std::mt19937 rng{std::random_device{}()};
-            std::uniform_int_distribution<int> lenDist(minimumDigits, maximumDigits);
-            int len = lenDist(rng);
-
-            uint64_t min = static_cast<uint64_t>(std::pow(10, len - 1));
-            uint64_t max = static_cast<uint64_t>(std::pow(10, len)) - 1;
+            if (minimumDigits < 1 || maximumDigits > 20 || minimumDigits > maximumDigits) {
+                throw std::invalid_argument("digit counts must satisfy 1 <= minimumDigits <= maximumDigits <= 20");
+            }
+            Xoshiro256 &gen = engine();
+            const auto len = static_cast<std::size_t>(minimumDigits) + uniform(gen, static_cast<std::uint64_t>(maximumDigits - minimumDigits + 1));
 
-            std::uniform_int_distribution<uint64_t> numDist(min, max);
-            return numDist(rng);
+            const std::uint64_t min = detail::powersOf10[len - 1];
+            // 20-digit numbers run up to the largest uint64_t
+            const std::uint64_t count = len < 20 ? detail::powersOf10[len] - min : std::numeric_limits<std::uint64_t>::max() - min + 1;
+            return min + uniform(gen, count);
         }
 
         /**
          * @brief Generates a random string of specified length.
          * @param length Length of the string to generate
          * @param characters Character set to use for generation
+         * @param source Source of randomness, Source::secure for session tokens and nonces
          * @return Random string
          * @throw std::invalid_argument if characters is empty or length is negative
          */
         inline std::string generateRandomString(
             int length,
-            std::string_view characters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789") {
+            std::string_view characters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789",
+            Source source = Source::fast) {
             if (characters.empty()) {
                 throw std::invalid_argument("characters list must not be empty");
             }
@@ -721,15 +1244,11 @@ namespace neko::util {
                 throw std::invalid_argument("length must be non-negative");
             }
 
-            static thread_local std::mt19937 rng{std::random_device{}()};
-            std::uniform_int_distribution<size_t> distribution(0, characters.size() - 1);
-
-            std::string randomString;
-            randomString.reserve(length);
-
-            for (int i = 0; i < length; ++i) {
-                randomString += characters[distribution(rng)];
-            }
+            std::string randomString(static_cast<std::size_t>(length), '\0');
+            if (source == Source::secure)
+                fillChars(secureEngine(), randomString, characters);
+            else
+                fillChars(engine(), randomString, characters);
             return randomString;
         }
     } // namespace random
@@ -7,18 +7,28 @@
 #include <neko/function/hash.hpp>
 #endif // NEKO_FUNCTION_ENABLE_HASH
 
+#include <neko/function/utilities.hpp>
 #include <neko/schema/exception.hpp>
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <compare>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <optional>
 #include <random>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 
 #endif // NEKO_FUNCTION_ENABLE_MODULE
@@ -28,35 +38,295 @@
  * @brief UUID generation and manipulation utilities.
  */
 namespace neko::util::uuid {
+
+    namespace detail {
+        inline constexpr std::uint8_t invalidHex = 0xFF;
+
+        inline constexpr std::array<std::uint8_t, 256> hexValues = [] {
+            std::array<std::uint8_t, 256> table{};
+            table.fill(invalidHex);
+            for (int i = 0; i < 10; ++i)
+                table['0' + i] = static_cast<std::uint8_t>(i);
+            for (int i = 0; i < 6; ++i) {
+                table['a' + i] = static_cast<std::uint8_t>(10 + i);
+                table['A' + i] = static_cast<std::uint8_t>(10 + i);
+            }
+            return table;
+        }();
+
+        // Two lowercase hex characters for every byte value
+        inline constexpr std::array<char, 512> hexPairs = [] {
+            constexpr std::string_view digits = "0123456789abcdef";
+            std::array<char, 512> table{};
+            for (int i = 0; i < 256; ++i) {
+                table[2 * i] = digits[i >> 4];
+                table[2 * i + 1] = digits[i & 0x0F];
+            }
+            return table;
+        }();
+
+        // Offsets of the 16 bytes within the canonical 8-4-4-4-12 form
+        inline constexpr std::array<std::uint8_t, 16> canonicalOffsets = {0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+
+        /**
+         * @brief Reserves count consecutive version 7 stamps, shared by all threads.
+         *
+         * A stamp is the 48-bit Unix millisecond time followed by a 12-bit counter (RFC 9562 section 6.2,
+         * method 3). Stamps strictly increase; when the counter runs out within a millisecond the time
+         * field is advanced, as the RFC allows.
+         * @return The first reserved stamp
+         */
+        inline std::uint64_t reserveV7Stamps(std::size_t count) noexcept {
+            static std::atomic<std::uint64_t> last{0};
+            const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            const std::uint64_t now = static_cast<std::uint64_t>(millis) << 12;
+            std::uint64_t previous = last.load(std::memory_order_relaxed);
+            std::uint64_t first = 0;
+            do {
+                first = std::max(now, previous + 1);
+            } while (!last.compare_exchange_weak(previous, first + count - 1, std::memory_order_relaxed));
+            return first;
+        }
+    } // namespace detail
+
+    /**
+     * @brief A UUID held as its 16 big-endian bytes.
+     *
+     * Trivially copyable and ordered byte-wise, which matches the RFC 9562 ordering and sorts version 7
+     * UUIDs by time. Usable as a key of std::unordered_map through the std::hash specialization.
+     */
+    class Uuid {
+    public:
+        /// Length of the canonical "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" form.
+        static constexpr std::size_t stringSize = 36;
+
+        /**
+         * @brief The nil UUID, all zero.
+         */
+        constexpr Uuid() noexcept = default;
+
+        constexpr explicit Uuid(const std::array<std::uint8_t, 16> &bytes) noexcept
+            : data(bytes) {}
+
+        /**
+         * @brief Parses and validates a UUID.
+         * Accepts the canonical form, the canonical form in braces, and 32 hex digits without hyphens, in any case.
+         * @return The UUID, or std::nullopt if the text is not one of these forms
+         */
+        static constexpr std::optional<Uuid> parse(std::string_view text) noexcept {
+            if (text.size() == stringSize + 2 && text.front() == '{' && text.back() == '}')
+                text = text.substr(1, stringSize);
+            Uuid result;
+            if (text.size() == stringSize) {
+                if (text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-')
+                    return std::nullopt;
+                for (std::size_t i = 0; i < 16; ++i) {
+                    if (!parseByte(text, detail::canonicalOffsets[i], result.data[i]))
+                        return std::nullopt;
+                }
+                return result;
+            }
+            if (text.size() == 32) {
+                for (std::size_t i = 0; i < 16; ++i) {
+                    if (!parseByte(text, 2 * i, result.data[i]))
+                        return std::nullopt;
+                }
+                return result;
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Generates a version 4 (random) UUID.
+         */
+        static Uuid v4() {
+            Uuid result;
+            v4(std::span(&result, 1));
+            return result;
+        }
+
+        /**
+         * @brief Fills out with version 4 UUIDs.
+         */
+        static void v4(std::span<Uuid> out) {
+            random::Xoshiro256 &gen = random::engine();
+            for (Uuid &uuid : out) {
+                uuid.storeHigh(gen());
+                uuid.storeLow(gen());
+                uuid.setVersion(4);
+            }
+        }
+
+        /**
+         * @brief Generates a version 7 (Unix time ordered) UUID.
+         * UUIDs generated by one process, from any thread, are strictly increasing.
+         */
+        static Uuid v7() {
+            Uuid result;
+            v7(std::span(&result, 1));
+            return result;
+        }
+
+        /**
+         * @brief Fills out with increasing version 7 UUIDs, reading the clock once.
+         */
+        static void v7(std::span<Uuid> out) {
+            if (out.empty())
+                return;
+            random::Xoshiro256 &gen = random::engine();
+            std::uint64_t stamp = detail::reserveV7Stamps(out.size());
+            for (Uuid &uuid : out) {
+                // 48-bit time, 4-bit version, 12-bit counter
+                uuid.storeHigh(((stamp >> 12) << 16) | (stamp & 0xFFF));
+                uuid.storeLow(gen());
+                uuid.setVersion(7);
+                ++stamp;
+            }
+        }
+
+        /**
+         * @brief Generates a version 3 (MD5, name-based) UUID.
+         * @note Requires hash support
+         * @throws neko::ex::NotImplemented if hash support is not enabled
+         */
+        static Uuid v3(std::string_view name, const Uuid &namespaceId);
+
+        /**
+         * @brief Generates a version 3 UUID in the DNS namespace.
+         */
+        static Uuid v3(std::string_view name);
+
+        /**
+         * @brief Generates a version 5 (SHA-1, name-based) UUID.
+         * @note Requires hash support
+         * @throws neko::ex::NotImplemented if hash support is not enabled
+         */
+        static Uuid v5(std::string_view name, const Uuid &namespaceId);
+
+        /**
+         * @brief Generates a version 5 UUID in the DNS namespace.
+         */
+        static Uuid v5(std::string_view name);
+
+        /**
+         * @brief The Unix time in milliseconds of a version 7 UUID.
+         */
+        constexpr std::uint64_t unixMillis() const noexcept {
+            std::uint64_t millis = 0;
+            for (int i = 0; i < 6; ++i)
+                millis = (millis << 8) | data[i];
+            return millis;
+        }
+
+        constexpr const std::array<std::uint8_t, 16> &bytes() const noexcept {
+            return data;
+        }
+
+        /**
+         * @brief The version field, such as 4 for random UUIDs.
+         */
+        constexpr int version() const noexcept {
+            return data[6] >> 4;
+        }
+
+        constexpr bool isNil() const noexcept {
+            return *this == Uuid{};
+        }
+
+        /**
+         * @brief Writes the canonical lowercase form.
+         * @param out Destination of stringSize characters; no terminator is written
+         * @return Pointer past the last character written
+         */
+        constexpr char *toChars(char *out) const noexcept {
+            for (std::size_t i = 0; i < 16; ++i) {
+                out[detail::canonicalOffsets[i]] = detail::hexPairs[2 * data[i]];
+                out[detail::canonicalOffsets[i] + 1] = detail::hexPairs[2 * data[i] + 1];
+            }
+            out[8] = out[13] = out[18] = out[23] = '-';
+            return out + stringSize;
+        }
+
+        /**
+         * @brief The canonical lowercase form.
+         */
+        std::string toString() const {
+            std::string result(stringSize, '\0');
+            toChars(result.data());
+            return result;
+        }
+
+        std::size_t hash() const noexcept {
+            std::uint64_t high, low;
+            std::memcpy(&high, data.data(), 8);
+            std::memcpy(&low, data.data() + 8, 8);
+            std::uint64_t h = (high ^ (low * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull;
+            h ^= h >> 31;
+            return static_cast<std::size_t>(h);
+        }
+
+        friend constexpr bool operator==(const Uuid &, const Uuid &) noexcept = default;
+        friend constexpr auto operator<=>(const Uuid &, const Uuid &) noexcept = default;
+
+    private:
+        static constexpr bool parseByte(std::string_view text, std::size_t pos, std::uint8_t &out) noexcept {
+            const std::uint8_t high = detail::hexValues[static_cast<unsigned char>(text[pos])];
+            const std::uint8_t low = detail::hexValues[static_cast<unsigned char>(text[pos + 1])];
+            if (high == detail::invalidHex || low == detail::invalidHex)
+                return false;
+            out = static_cast<std::uint8_t>((high << 4) | low);
+            return true;
+        }
+
+        constexpr void storeHigh(std::uint64_t value) noexcept {
+            for (int i = 0; i < 8; ++i)
+                data[i] = static_cast<std::uint8_t>(value >> (56 - 8 * i));
+        }
+
+        constexpr void storeLow(std::uint64_t value) noexcept {
+            for (int i = 0; i < 8; ++i)
+                data[8 + i] = static_cast<std::uint8_t>(value >> (56 - 8 * i));
+        }
+
+        // Name-based UUID from the first 16 bytes of the digest of namespace + name
+        static Uuid fromName(std::string_view name, const Uuid &namespaceId, int version);
+
+        // Stamps the version and the RFC 9562 variant (10xx)
+        constexpr void setVersion(int version) noexcept {
+            data[6] = static_cast<std::uint8_t>((data[6] & 0x0F) | (version << 4));
+            data[8] = static_cast<std::uint8_t>((data[8] & 0x3F) | 0x80);
+        }
+
+        std::array<std::uint8_t, 16> data{};
+    };
+
+    /**
+     * @brief Predefined namespace IDs for name-based UUIDs (RFC 9562 section 6.6).
+     */
+    inline constexpr Uuid namespaceDns = *Uuid::parse("6ba7b810-9dad-11d1-80b4-00c04fd430c8");
+    inline constexpr Uuid namespaceUrl = *Uuid::parse("6ba7b811-9dad-11d1-80b4-00c04fd430c8");
+    inline constexpr Uuid namespaceOid = *Uuid::parse("6ba7b812-9dad-11d1-80b4-00c04fd430c8");
+    inline constexpr Uuid namespaceX500 = *Uuid::parse("6ba7b814-9dad-11d1-80b4-00c04fd430c8");
+
     /**
      * @brief Generates a version 4 (random) UUID.
      * @return UUID string in standard format
      */
     inline std::string uuidV4() {
-        static thread_local std::mt19937 gen{std::random_device{}()};
-        static thread_local std::uniform_int_distribution<uint32_t> dis(0, 0xffffffff);
-
-        uint32_t data[4];
-        for (auto &d : data)
-            d = dis(gen);
-
-        // Set the version (4) and variant (10xx)
-        data[1] = (data[1] & 0xFFFF0FFF) | 0x00004000;
-        data[2] = (data[2] & 0x3FFFFFFF) | 0x80000000;
-
-        char buf[37];
-        std::snprintf(
-            buf, sizeof(buf),
-            "%08x-%04x-%04x-%04x-%04x%08x",
-            data[0],
-            (data[1] >> 16) & 0xFFFF, data[1] & 0xFFFF,
-            (data[2] >> 16) & 0xFFFF, data[2] & 0xFFFF,
-            data[3]);
-        return std::string(buf);
+        return Uuid::v4().toString();
+    }
+
+    /**
+     * @brief Generates a version 7 (Unix time ordered) UUID.
+     * @return UUID string in standard format; strings from one process sort in generation order
+     */
+    inline std::string uuidV7() {
+        return Uuid::v7().toString();
     }
 
     /**
      * @brief Converts a UUID string to bytes.
+     * Characters that are not hex digits are skipped; use Uuid::parse to validate.
      * @param uuid UUID string in standard format
      * @return Array of 16 bytes representing the UUID
      */
@@ -103,34 +373,62 @@ namespace neko::util::uuid {
      * @throws neko::ex::NotImplemented if hash support is not enabled
      */
     inline std::string uuidV3(const std::string &name, const std::string &namespaceUUID = "6ba7b810-9dad-11d1-80b4-00c04fd430c8") {
-#if defined(NEKO_FUNCTION_ENABLE_HASH)
-        auto ns_bytes = uuidStringToBytes(namespaceUUID);
-
-        std::string to_hash(reinterpret_cast<const char *>(ns_bytes.data()), ns_bytes.size());
-        to_hash += name;
+        return Uuid::v3(name, Uuid(uuidStringToBytes(namespaceUUID))).toString();
+    }
 
-        std::string md5hex = hash::digest(to_hash, hash::Algorithm::md5);
+    /**
+     * @brief Generates a version 5 UUID based on a namespace UUID and a name.
+     * @param name Name to use for UUID generation
+     * @param namespaceUUID Namespace UUID in string format
+     * @return Version 5 UUID string
+     *
+     * @note This requires using hash values, so OpenSSL support is needed
+     * @throws neko::ex::NotImplemented if hash support is not enabled
+     */
+    inline std::string uuidV5(const std::string &name, const std::string &namespaceUUID = "6ba7b810-9dad-11d1-80b4-00c04fd430c8") {
+        return Uuid::v5(name, Uuid(uuidStringToBytes(namespaceUUID))).toString();
+    }
 
-        std::array<uint8_t, 16> hash_bytes{};
-        for (int i = 0; i < 16; ++i) {
-            hash_bytes[i] = static_cast<uint8_t>(std::stoi(md5hex.substr(i * 2, 2), nullptr, 16));
-        }
+    inline Uuid Uuid::fromName(std::string_view name, const Uuid &namespaceId, int version) {
+#if defined(NEKO_FUNCTION_ENABLE_HASH)
+        std::string toHash(reinterpret_cast<const char *>(namespaceId.data.data()), namespaceId.data.size());
+        toHash += name;
 
-        hash_bytes[6] = (hash_bytes[6] & 0x0F) | 0x30; // version 3
-        hash_bytes[8] = (hash_bytes[8] & 0x3F) | 0x80; // RFC4122 variant
+        hash::Digest digest = hash::digestRaw(toHash, version == 3 ? hash::Algorithm::md5 : hash::Algorithm::sha1);
 
-        std::ostringstream oss;
-        oss << std::hex << std::setfill('0');
-        for (int i = 0; i < 16; ++i) {
-            oss << std::setw(2) << static_cast<int>(hash_bytes[i]);
-            if (i == 3 || i == 5 || i == 7 || i == 9)
-                oss << '-';
-        }
-        return oss.str();
+        Uuid result;
+        std::copy_n(digest.begin(), result.data.size(), result.data.begin());
+        result.setVersion(version);
+        return result;
 #else
-#pragma message("uuid.hpp: uuidV3 requires hash support. Please install OpenSSL and set NEKO_FUNCTION_ENABLE_HASH = ON in CMake.")
-        throw ex::NotImplemented("UUID v3 requires hash support. Please compile with NEKO_FUNCTION_ENABLE_HASH=ON and install OpenSSL.");
+#pragma message("uuid.hpp: uuidV3 and uuidV5 require hash support. Please install OpenSSL and set NEKO_FUNCTION_ENABLE_HASH = ON in CMake.")
+        (void)name;
+        (void)namespaceId;
+        throw ex::NotImplemented("UUID v" + std::to_string(version) + " requires hash support. Please compile with NEKO_FUNCTION_ENABLE_HASH=ON and install OpenSSL.");
 #endif // NEKO_FUNCTION_ENABLE_HASH
     }
 
-} // namespace neko::util::uuid
\ No newline at end of file
+    inline Uuid Uuid::v3(std::string_view name, const Uuid &namespaceId) {
+        return fromName(name, namespaceId, 3);
+    }
+
+    inline Uuid Uuid::v3(std::string_view name) {
+        return v3(name, namespaceDns);
+    }
+
+    inline Uuid Uuid::v5(std::string_view name, const Uuid &namespaceId) {
+        return fromName(name, namespaceId, 5);
+    }
+
+    inline Uuid Uuid::v5(std::string_view name) {
+        return v5(name, namespaceDns);
+    }
+
+} // namespace neko::util::uuid
+
+template <>
+struct std::hash<neko::util::uuid::Uuid> {
+    std::size_t operator()(const neko::util::uuid::Uuid &uuid) const noexcept {
+        return uuid.hash();
+    }
+};
\ No newline at end of file
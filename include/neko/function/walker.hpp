@@ -0,0 +1,198 @@
+/**
+ * @file walker.hpp
+ * @brief Recursive file listing that prunes excluded directories
+ * @author moehoshio
+ * @copyright Copyright (c) 2025 Hoshi
+ * @license MIT OR Apache-2.0
+ */
+
+#pragma once
+
+// Include header for non-module usage
+#if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
+
+#include <neko/function/pattern.hpp>
+#include <neko/function/threadPool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#endif // NEKO_FUNCTION_ENABLE_MODULE
+
+/**
+ * @namespace neko::util::fs
+ * @brief Filesystem traversal utilities.
+ */
+namespace neko::util::fs {
+
+    /**
+     * @brief A regular file found by listFiles.
+     */
+    struct FileEntry {
+        std::filesystem::path path;
+        // Path relative to the parent of the absolute root, with '/' separators, e.g. "root/sub/file.txt"
+        std::string relativePath;
+        std::uintmax_t size = 0;
+    };
+
+    /**
+     * @brief Options for listFiles.
+     */
+    struct WalkConfig {
+        // Patterns in the syntax of pattern::CompiledPatternSet, matched against relative paths
+        std::vector<std::string> excludePaths;
+        // Directories listed concurrently on pool::defaultPool(), 0 for hardware concurrency; above 1 the result is sorted by relative path
+        std::size_t threads = 1;
+        // How wildcards in excludePaths are read
+        pattern::WildcardMode wildcardMode = pattern::WildcardMode::glob;
+    };
+
+    namespace detail {
+        // Appends name to a '/' separated relative path, which may be empty
+        inline std::string childPath(const std::string &parent, const std::filesystem::path &name) {
+            std::string leaf = name.generic_string();
+            if (parent.empty())
+                return leaf;
+            std::string child;
+            child.reserve(parent.size() + 1 + leaf.size());
+            child += parent;
+            child += '/';
+            child += leaf;
+            return child;
+        }
+
+        /**
+         * @brief Lists one directory: files go to out, subdirectories that are not pruned to subdirs.
+         * Uses the file type cached by the directory entry, so only files cost one stat for their size.
+         */
+        inline void listDirectory(const std::filesystem::path &dir, const std::string &relative, const pattern::CompiledPatternSet &excludes,
+                                  std::vector<FileEntry> &out, std::vector<std::pair<std::filesystem::path, std::string>> &subdirs) {
+            for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+                std::error_code ec;
+                std::string childRelative = childPath(relative, entry.path().filename());
+                // Symlinks to directories are reported as directories but, as with recursive_directory_iterator, not followed
+                if (entry.is_directory(ec)) {
+                    if (!entry.is_symlink(ec) && !excludes.matchDirectory(childRelative))
+                        subdirs.emplace_back(entry.path(), std::move(childRelative));
+                    continue;
+                }
+                if (!entry.is_regular_file(ec) || excludes.match(childRelative))
+                    continue;
+                FileEntry file{entry.path(), std::move(childRelative), 0};
+                file.size = entry.file_size(ec);
+                out.push_back(std::move(file));
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief Lists the regular files below root, skipping excluded directories without descending into them.
+     *
+     * A directory is pruned when CompiledPatternSet::matchDirectory() says every path below it is excluded;
+     * other files are matched one by one, so the result equals filtering a full recursive listing.
+     * Symbolic links to files are listed, symbolic links to directories are not followed.
+     * @param root Directory to walk; relative paths start with its name, unless it names itself as "dir/" or "."
+     * With several threads the caller lists directories too, helped by tasks on pool::defaultPool().
+     * @param config Exclude patterns and parallelism
+     * @return The files found
+     * @throws std::filesystem::filesystem_error if a directory cannot be read
+     */
+    inline std::vector<FileEntry> listFiles(const std::filesystem::path &root, const WalkConfig &config = {}) {
+        const pattern::CompiledPatternSet excludes(config.excludePaths, config.wildcardMode);
+        // Computed once for the root instead of once per file
+        std::string rootRelative = std::filesystem::relative(root, std::filesystem::absolute(root).parent_path()).generic_string();
+        if (rootRelative == ".")
+            rootRelative.clear();
+        std::vector<FileEntry> files;
+        if (!rootRelative.empty() && excludes.matchDirectory(rootRelative))
+            return files;
+
+        const std::size_t threads = config.threads != 0 ? config.threads : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        if (threads <= 1) {
+            // Relative path of the directory at each depth of the iterator
+            std::vector<std::string> parents{rootRelative};
+            for (auto it = std::filesystem::recursive_directory_iterator(root); it != std::filesystem::recursive_directory_iterator(); ++it) {
+                const auto &entry = *it;
+                const auto depth = static_cast<std::size_t>(it.depth());
+                std::error_code ec;
+                std::string relative = detail::childPath(parents[depth], entry.path().filename());
+                if (entry.is_directory(ec)) {
+                    if (excludes.matchDirectory(relative)) {
+                        it.disable_recursion_pending();
+                    } else {
+                        parents.resize(depth + 1);
+                        parents.push_back(std::move(relative));
+                    }
+                    continue;
+                }
+                if (!entry.is_regular_file(ec) || excludes.match(relative))
+                    continue;
+                FileEntry file{entry.path(), std::move(relative), 0};
+                file.size = entry.file_size(ec);
+                files.push_back(std::move(file));
+            }
+            return files;
+        }
+
+        // Shared stack of directories; a worker waits while others may still push more.
+        // Only workers already listing count as busy, so the walk ends even if some helpers never start.
+        std::vector<std::pair<std::filesystem::path, std::string>> pending{{root, rootRelative}};
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::size_t busy = 0;
+        std::exception_ptr error;
+        std::vector<std::vector<FileEntry>> results(threads);
+
+        auto worker = [&](std::size_t index) {
+            std::vector<std::pair<std::filesystem::path, std::string>> found;
+            std::unique_lock lock(mutex);
+            while (true) {
+                wake.wait(lock, [&] { return !pending.empty() || busy == 0 || error; });
+                if (pending.empty() || error)
+                    break;
+                auto [dir, relative] = std::move(pending.back());
+                pending.pop_back();
+                ++busy;
+                lock.unlock();
+                try {
+                    detail::listDirectory(dir, relative, excludes, results[index], found);
+                } catch (...) {
+                    lock.lock();
+                    if (!error)
+                        error = std::current_exception();
+                    --busy;
+                    break;
+                }
+                lock.lock();
+                --busy;
+                for (auto &subdir : found)
+                    pending.push_back(std::move(subdir));
+                found.clear();
+                wake.notify_all();
+            }
+            wake.notify_all();
+        };
+
+        pool::runWorkers(threads, worker);
+        if (error)
+            std::rethrow_exception(error);
+
+        for (auto &part : results) {
+            files.insert(files.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+        }
+        std::sort(files.begin(), files.end(), [](const FileEntry &a, const FileEntry &b) { return a.relativePath < b.relativePath; });
+        return files;
+    }
+
+} // namespace neko::util::fs
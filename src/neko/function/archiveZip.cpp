@@ -2,15 +2,44 @@
 #if !defined(NEKO_FUNCTION_ENABLE_MODULE) || (NEKO_FUNCTION_ENABLE_MODULE == false)
 #include <neko/function/archive.hpp>
 #include <neko/schema/exception.hpp>
+#include <neko/function/fastHash.hpp>
+#include <neko/function/mappedFile.hpp>
 #include <neko/function/pattern.hpp>
+#include <neko/function/profile.hpp>
+#include <neko/function/threadPool.hpp>
+#include <neko/function/walker.hpp>
 
 #include <minizip-ng/mz.h>
+#include <minizip-ng/mz_os.h>
 #include <minizip-ng/mz_strm.h>
+#include <minizip-ng/mz_strm_mem.h>
 #include <minizip-ng/mz_zip.h>
 #include <minizip-ng/mz_zip_rw.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <ctime>
+#include <exception>
+#include <functional>
+#include <limits>
 #include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stop_token>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #endif
 
 namespace neko::archive::zip {
@@ -75,96 +104,1026 @@ namespace neko::archive::zip {
         const void *get() const { return handle; }
     };
 
-    void extract(const ExtractConfig &config) {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        // Serializes observer callbacks and accumulates the summary across threads
+        class Progress {
+            const ArchiveObserver &observer;
+            std::stop_token stopToken;
+            std::mutex mutex;
+            std::atomic<bool> stopped{false};
+            ArchiveSummary totals;
+            Clock::time_point begin = Clock::now();
+
+        public:
+            Progress(const ArchiveObserver &observer, std::stop_token stopToken)
+                : observer(observer), stopToken(std::move(stopToken)) {}
+
+            bool cancelled() const {
+                return stopped.load(std::memory_order_relaxed) || stopToken.stop_requested();
+            }
+
+            // Returns false if the operation is cancelled, in which case the entry must not be processed
+            bool start(std::string_view name, std::int64_t compressedSize, std::int64_t uncompressedSize) {
+                if (cancelled())
+                    return false;
+                if (observer.onEntryStart) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!observer.onEntryStart(EntryEvent{name, compressedSize, uncompressedSize, {}}))
+                        stopped.store(true, std::memory_order_relaxed);
+                }
+                return !cancelled();
+            }
+
+            void finish(std::string_view name, std::int64_t compressedSize, std::int64_t uncompressedSize, Clock::duration elapsed) {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++totals.entries;
+                totals.compressedBytes += static_cast<std::uint64_t>(compressedSize);
+                totals.uncompressedBytes += static_cast<std::uint64_t>(uncompressedSize);
+                if (observer.onEntryFinish &&
+                    !observer.onEntryFinish(EntryEvent{name, compressedSize, uncompressedSize, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)}))
+                    stopped.store(true, std::memory_order_relaxed);
+            }
+
+            void addTimes(Clock::duration codec, Clock::duration io) {
+                std::lock_guard<std::mutex> lock(mutex);
+                totals.codecTime += std::chrono::duration_cast<std::chrono::nanoseconds>(codec);
+                totals.ioTime += std::chrono::duration_cast<std::chrono::nanoseconds>(io);
+            }
+
+            ArchiveSummary summary() {
+                std::lock_guard<std::mutex> lock(mutex);
+                ArchiveSummary result = totals;
+                result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin);
+                result.cancelled = cancelled();
+                return result;
+            }
+        };
+
+        // An entry selected on the central directory pass, extracted later by a worker thread
+        struct PlannedEntry {
+            std::int64_t cdPos;
+            std::int64_t size;
+            std::int64_t compressedSize;
+            std::string name;
+            std::string outPath;
+            // Set for OverwritePolicy::ifChanged when the existing file has the entry's size
+            bool skipIfIdentical = false;
+            std::uint32_t crc = 0;
+        };
+
+        constexpr std::int32_t extractBufferSize = 256 * 1024;
+
+        // Entry names, and the output paths built from them, are UTF-8 as minizip-ng expects.
+        // Going through char8_t keeps them intact where the narrow encoding is not UTF-8, i.e. on Windows
+        std::filesystem::path utf8Path(std::string_view path) {
+            return std::filesystem::path(std::u8string(path.begin(), path.end()));
+        }
+
+        std::string utf8String(const std::filesystem::path &path) {
+            const std::u8string text = path.u8string();
+            return std::string(text.begin(), text.end());
+        }
+
+        std::uint32_t crc32OfFile(const std::string &path) {
+            std::ifstream in(utf8Path(path), std::ios::binary);
+            std::vector<char> buffer(extractBufferSize);
+            std::uint32_t crc = 0;
+            while (in.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || in.gcount() > 0) {
+                crc = util::hash::crc32(buffer.data(), static_cast<std::size_t>(in.gcount()), crc);
+            }
+            return crc;
+        }
+
+        bool isSelected(const util::pattern::CompiledPatternSet &includes, const util::pattern::CompiledPatternSet &excludes, std::string_view name) {
+            return !excludes.match(name) && (includes.empty() || includes.match(name));
+        }
+
+        // minizip-ng memory streams address at most INT32_MAX bytes
+        std::int32_t memoryLength(std::size_t size, const std::string &what) {
+            if (size > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+                throw ex::InvalidArgument(what + " exceeds the 2 GiB in-memory limit");
+            return static_cast<std::int32_t>(size);
+        }
+
+        // Opens a reader on the mapped archive, so entries are inflated straight from the page cache.
+        // Falls back to minizip's file stream for streams and archives above its 2 GiB buffer limit
+        bool openArchive(void *reader, const util::fs::MappedFile &archive, const std::string &path) {
+            const auto bytes = archive.bytes();
+            if (archive.isContiguous() && !bytes.empty() && bytes.size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+                return mz_zip_reader_open_buffer(reader, reinterpret_cast<std::uint8_t *>(const_cast<std::byte *>(bytes.data())),
+                                                 static_cast<std::int32_t>(bytes.size()), 0) == MZ_OK;
+            return mz_zip_reader_open_file(reader, path.c_str()) == MZ_OK;
+        }
+
+        // Maps the archive if possible; on failure openArchive reports the error through minizip
+        util::fs::MappedFile mapArchive(const std::string &path) {
+            std::error_code ec;
+            util::fs::MappedFile archive(path, ec, util::fs::AccessHint::normal);
+            return archive;
+        }
+
+        // Extracts one entry through the low-level zip handle, applying the same date and attributes as mz_zip_reader_entry_save_file
+        void saveEntryAt(void *zipHandle, const PlannedEntry &entry, const std::string &password, std::vector<char> &buffer, Progress &progress) {
+            if (entry.skipIfIdentical && crc32OfFile(entry.outPath) == entry.crc)
+                return;
+            if (!progress.start(entry.name, entry.compressedSize, entry.size))
+                return;
+            NEKO_FUNCTION_PROFILE_SCOPE(timer, "archive.zip.inflateEntry");
+            NEKO_FUNCTION_PROFILE_BYTES(timer, entry.size);
+            const auto entryBegin = Clock::now();
+
+            if (mz_zip_goto_entry(zipHandle, entry.cdPos) != MZ_OK)
+                throw ex::FileError("Failed to locate entry: " + entry.name);
+
+            mz_zip_file *fileInfo = nullptr;
+            if (mz_zip_entry_get_info(zipHandle, &fileInfo) != MZ_OK || !fileInfo)
+                throw ex::FileError("Failed to read entry info: " + entry.name);
+
+            // A stop that arrived after start() leaves an existing output file untouched
+            if (progress.cancelled())
+                return;
+            if (mz_zip_entry_read_open(zipHandle, 0, password.empty() ? nullptr : password.c_str()) != MZ_OK)
+                throw ex::FileError("Failed to open entry: " + entry.name);
+
+            std::ofstream out(utf8Path(entry.outPath), std::ios::binary | std::ios::trunc);
+            neko::int32 read = 0;
+            Clock::duration codec{}, io{};
+            while (out && !progress.cancelled()) {
+                auto readBegin = Clock::now();
+                read = mz_zip_entry_read(zipHandle, buffer.data(), static_cast<std::int32_t>(buffer.size()));
+                auto writeBegin = Clock::now();
+                codec += writeBegin - readBegin;
+                if (read <= 0)
+                    break;
+                out.write(buffer.data(), read);
+                io += Clock::now() - writeBegin;
+            }
+            out.close();
+            // Closing the entry also verifies the CRC
+            neko::int32 err = mz_zip_entry_close(zipHandle);
+            progress.addTimes(codec, io);
+            if (progress.cancelled()) {
+                // Stopped after the output was truncated, do not leave a partial or empty file behind
+                std::error_code ec;
+                std::filesystem::remove(utf8Path(entry.outPath), ec);
+                return;
+            }
+            if (!out || read < 0 || err != MZ_OK)
+                throw ex::FileError("Failed to extract file: " + entry.name);
+
+            std::uint32_t targetAttrib = 0;
+            if (mz_zip_attrib_convert(MZ_HOST_SYSTEM(fileInfo->version_madeby), fileInfo->external_fa, MZ_VERSION_MADEBY_HOST_SYSTEM, &targetAttrib) == MZ_OK)
+                mz_os_set_file_attribs(entry.outPath.c_str(), targetAttrib);
+            mz_os_set_file_date(entry.outPath.c_str(), fileInfo->modified_date, fileInfo->accessed_date, fileInfo->creation_date);
+            progress.finish(entry.name, entry.compressedSize, entry.size, Clock::now() - entryBegin);
+        }
+
+        // Splits the planned entries across the calling thread and pool helpers, each with its own reader handle on the archive
+        void extractPlanned(const ExtractConfig &config, const util::fs::MappedFile &archive, std::vector<PlannedEntry> &planned, std::size_t threads, Progress &progress) {
+            // Largest entries first, so one big file does not end up last on a single thread
+            std::sort(planned.begin(), planned.end(), [](const PlannedEntry &a, const PlannedEntry &b) {
+                return a.size > b.size;
+            });
+            threads = std::min(threads, planned.size());
+
+            std::atomic<std::size_t> next{0};
+            std::atomic<bool> failed{false};
+            std::exception_ptr firstError;
+            std::atomic_flag errorSet = ATOMIC_FLAG_INIT;
+
+            auto worker = [&]() {
+                try {
+                    ZipReader reader;
+                    if (!openArchive(reader.get(), archive, config.inputArchivePath))
+                        throw ex::FileError("Failed to open zip file for reading: " + config.inputArchivePath);
+                    void *zipHandle = nullptr;
+                    mz_zip_reader_get_zip_handle(reader.get(), &zipHandle);
+
+                    std::vector<char> buffer(extractBufferSize);
+                    while (!failed.load(std::memory_order_relaxed) && !progress.cancelled()) {
+                        std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                        if (i >= planned.size())
+                            break;
+                        saveEntryAt(zipHandle, planned[i], config.password, buffer, progress);
+                    }
+                } catch (...) {
+                    if (!errorSet.test_and_set())
+                        firstError = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            };
+
+            util::pool::runWorkers(threads, [&](std::size_t) { worker(); });
+
+            if (firstError)
+                std::rethrow_exception(firstError);
+        }
+
+        // RAII for a growable minizip-ng memory stream
+        class MemoryStream {
+            void *handle = nullptr;
+
+        public:
+            MemoryStream() {
+                handle = mz_stream_mem_create();
+                if (!handle)
+                    throw ex::Runtime("Failed to create memory stream");
+                mz_stream_mem_set_grow_size(handle, 128 * 1024);
+                mz_stream_open(handle, nullptr, MZ_OPEN_MODE_CREATE);
+            }
+            ~MemoryStream() {
+                if (handle)
+                    mz_stream_mem_delete(&handle);
+            }
+            MemoryStream(const MemoryStream &) = delete;
+            MemoryStream &operator=(const MemoryStream &) = delete;
+
+            void *get() { return handle; }
+
+            // Copies the bytes written so far
+            std::vector<neko::uchar> contents() {
+                const void *data = nullptr;
+                std::int32_t length = 0;
+                mz_stream_mem_get_buffer(handle, &data);
+                mz_stream_mem_get_buffer_length(handle, &length);
+                if (!data || length <= 0)
+                    return {};
+                const auto *bytes = static_cast<const neko::uchar *>(data);
+                return std::vector<neko::uchar>(bytes, bytes + length);
+            }
+        };
+
+        // A file selected for the archive, in the order the entries are written
+        struct PendingFile {
+            std::string sourcePath;
+            std::string entryName;
+            // Too large to buffer in memory, compressed by the writing thread itself
+            bool direct = false;
+            // Unchanged since the previous incremental run, copied raw from the previous archive
+            bool reuse = false;
+            // Central directory position of the entry in the previous archive, set when reuse is
+            std::int64_t previousEntry = 0;
+            std::uintmax_t size = 0;
+            std::int64_t mtime = 0;
+        };
+
+        // Files at or above this size are never buffered by the parallel path
+        constexpr std::uintmax_t maxBufferedFileSize = 64ull * 1024 * 1024;
+        // Source bytes the parallel path buffers at once, so peak memory does not grow with the thread count
+        constexpr std::uintmax_t maxBufferedBytes = 4 * maxBufferedFileSize;
+
+        struct WriterSettings {
+            std::uint16_t method;
+            std::int16_t level;
+        };
+
+        WriterSettings writerSettings(CompressionLevel level) {
+            switch (level) {
+                case CompressionLevel::none:
+                    return {MZ_COMPRESS_METHOD_STORE, 0};
+                case CompressionLevel::fast:
+                    return {MZ_COMPRESS_METHOD_DEFLATE, MZ_COMPRESS_LEVEL_FAST};
+                case CompressionLevel::maximum:
+                case CompressionLevel::ultra:
+                    return {MZ_COMPRESS_METHOD_DEFLATE, MZ_COMPRESS_LEVEL_BEST};
+                case CompressionLevel::normal:
+                default:
+                    return {MZ_COMPRESS_METHOD_DEFLATE, MZ_COMPRESS_LEVEL_NORMAL};
+            }
+        }
+
+        // Formats whose payload is already compressed, as named by util::detect::detectFileType
+        constexpr bool isCompressedFormat(util::detect::FileType type) {
+            using util::detect::FileType;
+            constexpr util::detect::FileTypeSet compressedTypes{
+                FileType::png, FileType::jpeg, FileType::gif, FileType::mp3, FileType::ogg, FileType::flac,
+                FileType::mp4, FileType::mov, FileType::mkv, FileType::zip, FileType::docx, FileType::xlsx,
+                FileType::pptx, FileType::apk, FileType::rar, FileType::sevenZip, FileType::gz, FileType::bz2,
+                FileType::lzma, FileType::xz, FileType::zst, FileType::lzo, FileType::lz4};
+            return compressedTypes.contains(type);
+        }
+
+        void configureWriter(void *writer, const CreateConfig &config, const WriterSettings &settings) {
+            mz_zip_writer_set_compress_method(writer, settings.method);
+            mz_zip_writer_set_compress_level(writer, settings.level);
+            if (!config.password.empty()) {
+                mz_zip_writer_set_password(writer, config.password.c_str());
+                switch (config.encryption) {
+                    case ZipEncryption::AES256:
+                        mz_zip_writer_set_aes(writer, 1);
+                        break;
+                    case ZipEncryption::ZipCrypto:
+                    default:
+                        mz_zip_writer_set_aes(writer, 0);
+                        break;
+                }
+            }
+        }
+
+        // Adds one file with the configured settings, storing it when its content is already compressed
+        void addFile(void *writer, const CreateConfig &config, const WriterSettings &settings, const PendingFile &file) {
+            NEKO_FUNCTION_PROFILE_SCOPE(timer, "archive.zip.deflateEntry");
+            NEKO_FUNCTION_PROFILE_BYTES(timer, file.size);
+            bool store = settings.method != MZ_COMPRESS_METHOD_STORE && config.storeCompressedInputs &&
+                         isCompressedFormat(util::detect::identifyFileType(file.sourcePath));
+            if (store)
+                mz_zip_writer_set_compress_method(writer, MZ_COMPRESS_METHOD_STORE);
+            neko::int32 err = mz_zip_writer_add_file(writer, file.sourcePath.c_str(), file.entryName.c_str());
+            if (store)
+                mz_zip_writer_set_compress_method(writer, settings.method);
+            if (err != MZ_OK)
+                throw ex::FileError("Failed to add file: " + file.entryName + " in zip: " + config.outputArchivePath);
+        }
+
+        // Current end of the archive being written, used to measure the bytes each entry takes
+        std::int64_t archiveOffset(void *writer) {
+            void *zipHandle = nullptr;
+            void *stream = nullptr;
+            mz_zip_writer_get_zip_handle(writer, &zipHandle);
+            if (!zipHandle || mz_zip_get_stream(zipHandle, &stream) != MZ_OK || !stream)
+                return 0;
+            return mz_stream_tell(stream);
+        }
+
+        // Writes a file on the writing thread: copied from the previous archive, or compressed in place
+        void writeDirect(void *writer, void *previous, const CreateConfig &config, const WriterSettings &settings, const PendingFile &file, Progress &progress) {
+            if (!progress.start(file.entryName, 0, static_cast<std::int64_t>(file.size)))
+                return;
+            const auto begin = Clock::now();
+            const std::int64_t offset = archiveOffset(writer);
+            if (file.reuse) {
+                // Seek by central directory position, as locating by name rescans the directory for every file
+                void *zipHandle = nullptr;
+                mz_zip_reader_get_zip_handle(previous, &zipHandle);
+                mz_zip_file *fileInfo = nullptr;
+                if (!zipHandle || mz_zip_goto_entry(zipHandle, file.previousEntry) != MZ_OK ||
+                    mz_zip_reader_entry_get_info(previous, &fileInfo) != MZ_OK || !fileInfo || !fileInfo->filename ||
+                    file.entryName != fileInfo->filename ||
+                    mz_zip_writer_copy_from_reader(writer, previous) != MZ_OK)
+                    throw ex::FileError("Failed to copy unchanged file: " + file.entryName + " in zip: " + config.outputArchivePath);
+            } else {
+                addFile(writer, config, settings, file);
+            }
+            const auto elapsed = Clock::now() - begin;
+            if (file.reuse)
+                progress.addTimes({}, elapsed);
+            else
+                progress.addTimes(elapsed, {});
+            progress.finish(file.entryName, archiveOffset(writer) - offset, static_cast<std::int64_t>(file.size), elapsed);
+        }
+
+        // Compresses one file into a single-entry archive held in memory
+        std::vector<neko::uchar> compressToMemory(const CreateConfig &config, const WriterSettings &settings, const PendingFile &file) {
+            MemoryStream stream;
+            {
+                ZipWriter writer;
+                if (mz_zip_writer_open(writer.get(), stream.get(), 0) != MZ_OK)
+                    throw ex::Runtime("Failed to open in-memory zip writer");
+                configureWriter(writer.get(), config, settings);
+                addFile(writer.get(), config, settings, file);
+                writer.close();
+            }
+
+            auto data = stream.contents();
+            if (data.empty())
+                throw ex::FileError("Failed to compress file: " + file.entryName);
+            return data;
+        }
+
+        // Copies the single entry of an in-memory archive into the output archive without recompressing it
+        void copyCompressed(void *writer, const CreateConfig &config, std::vector<neko::uchar> &data, const PendingFile &file) {
+            ZipReader reader;
+            if (mz_zip_reader_open_buffer(reader.get(), data.data(), static_cast<std::int32_t>(data.size()), 0) != MZ_OK ||
+                mz_zip_reader_goto_first_entry(reader.get()) != MZ_OK ||
+                mz_zip_writer_copy_from_reader(writer, reader.get()) != MZ_OK)
+                throw ex::FileError("Failed to add file: " + file.entryName + " in zip: " + config.outputArchivePath);
+            reader.close();
+        }
+
+        // Compresses files on pool helpers and writes the results into the archive in input order.
+        // The writer compresses an entry itself when no helper has claimed it yet, so it never waits on a queued helper
+        void createParallel(void *writer, void *previous, const CreateConfig &config, const WriterSettings &settings,
+                            const std::vector<PendingFile> &files, std::size_t threads, Progress &progress) {
+            threads = std::min(threads, files.size());
+            // Bounds how many compressed entries wait in memory for the writer; maxBufferedBytes bounds their size
+            const std::size_t window = threads * 2;
+
+            struct Slot {
+                std::vector<neko::uchar> data;
+                Clock::duration compressTime{};
+                bool ready = false;
+            };
+            std::vector<Slot> slots(files.size());
+
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::size_t written = 0;
+            // Source sizes of the entries being compressed or waiting for the writer
+            std::uintmax_t buffered = 0;
+            std::vector<std::uintmax_t> reserved(files.size(), 0);
+            std::atomic<std::size_t> next{0};
+            // Set on error, on cancellation, and once the writer is done
+            bool stopped = false;
+            std::exception_ptr firstError;
+
+            auto stop = [&](std::exception_ptr error) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error && !firstError)
+                    firstError = error;
+                stopped = true;
+                cv.notify_all();
+            };
+
+            // Returns false if the observer cancelled the entry
+            auto compress = [&](std::size_t i, Slot &result) {
+                if (files[i].direct || files[i].reuse)
+                    return true;
+                if (!progress.start(files[i].entryName, 0, static_cast<std::int64_t>(files[i].size)))
+                    return false;
+                auto begin = Clock::now();
+                result.data = compressToMemory(config, settings, files[i]);
+                result.compressTime = Clock::now() - begin;
+                progress.addTimes(result.compressTime, {});
+                return true;
+            };
+
+            auto worker = [&]() {
+                try {
+                    while (true) {
+                        std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                        if (i >= files.size())
+                            break;
+                        {
+                            const std::uintmax_t cost = files[i].direct || files[i].reuse ? 0 : files[i].size;
+                            std::unique_lock<std::mutex> lock(mutex);
+                            // The entry the writer needs next never waits for the budget, so the writer always progresses
+                            cv.wait(lock, [&] {
+                                return stopped || (i < written + window && (i == written || buffered + cost <= maxBufferedBytes));
+                            });
+                            if (stopped)
+                                break;
+                            buffered += cost;
+                            reserved[i] = cost;
+                        }
+                        Slot result;
+                        if (!compress(i, result)) {
+                            stop(nullptr);
+                            break;
+                        }
+                        std::lock_guard<std::mutex> lock(mutex);
+                        slots[i].data = std::move(result.data);
+                        slots[i].compressTime = result.compressTime;
+                        slots[i].ready = true;
+                        cv.notify_all();
+                    }
+                } catch (...) {
+                    stop(std::current_exception());
+                }
+            };
+
+            util::pool::TaskGroup helpers;
+            for (std::size_t t = 0; t < threads; ++t) {
+                helpers.run(worker);
+            }
+
+            try {
+                for (std::size_t i = 0; i < files.size() && !progress.cancelled(); ++i) {
+                    Slot slot;
+                    bool claimed = false;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        // next only grows, so once a helper has claimed i the writer waits for its slot
+                        cv.wait(lock, [&] { return stopped || slots[i].ready || next.load(std::memory_order_relaxed) <= i; });
+                        std::size_t expected = i;
+                        if (!slots[i].ready && !stopped)
+                            claimed = next.compare_exchange_strong(expected, i + 1, std::memory_order_relaxed);
+                        if (!slots[i].ready && !claimed) {
+                            cv.wait(lock, [&] { return stopped || slots[i].ready; });
+                            if (!slots[i].ready)
+                                break;
+                        }
+                        if (!claimed)
+                            slot = std::move(slots[i]);
+                    }
+                    if (claimed && !compress(i, slot))
+                        break;
+                    if (files[i].direct || files[i].reuse) {
+                        writeDirect(writer, previous, config, settings, files[i], progress);
+                    } else {
+                        const auto begin = Clock::now();
+                        const std::int64_t offset = archiveOffset(writer);
+                        copyCompressed(writer, config, slot.data, files[i]);
+                        const auto copyTime = Clock::now() - begin;
+                        progress.addTimes({}, copyTime);
+                        progress.finish(files[i].entryName, archiveOffset(writer) - offset, static_cast<std::int64_t>(files[i].size), slot.compressTime + copyTime);
+                    }
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    buffered -= reserved[i];
+                    ++written;
+                    cv.notify_all();
+                }
+                stop(nullptr);
+            } catch (...) {
+                stop(std::current_exception());
+            }
+
+            helpers.wait();
+
+            if (firstError)
+                std::rethrow_exception(firstError);
+        }
+
+        // Writes the files serially or through pool helpers, in input order
+        void writeFiles(void *writer, void *previous, const CreateConfig &config, const WriterSettings &settings, std::vector<PendingFile> &files, Progress &progress) {
+            std::size_t threads = config.threads != 0 ? config.threads : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+            if (threads > 1 && files.size() > 1) {
+                for (auto &file : files) {
+                    file.direct = file.size >= maxBufferedFileSize;
+                }
+                createParallel(writer, previous, config, settings, files, threads, progress);
+            } else {
+                for (const auto &file : files) {
+                    writeDirect(writer, previous, config, settings, file, progress);
+                }
+            }
+        }
+
+        std::vector<PendingFile> collectInputs(const CreateConfig &config) {
+            const util::pattern::CompiledPatternSet excludes(config.excludePaths, config.wildcardMode);
+            // Excluded directories are pruned rather than walked
+            const util::fs::WalkConfig walk{config.excludePaths, config.threads, config.wildcardMode};
+            std::vector<PendingFile> files;
+            for (const auto &input : config.inputPaths) {
+                if (std::filesystem::is_directory(input)) {
+                    for (auto &entry : util::fs::listFiles(input, walk)) {
+                        PendingFile file{entry.path.string(), std::move(entry.relativePath)};
+                        file.size = entry.size;
+                        files.push_back(std::move(file));
+                    }
+                } else {
+                    std::string filePath = std::filesystem::path(input).filename().string();
+                    if (excludes.match(filePath))
+                        continue;
+                    PendingFile file{input, std::move(filePath)};
+                    std::error_code ec;
+                    file.size = std::filesystem::file_size(input, ec);
+                    files.push_back(std::move(file));
+                }
+            }
+            return files;
+        }
+
+        // One manifest line: the source file state an archive entry was built from
+        struct ManifestRecord {
+            std::uintmax_t size = 0;
+            std::int64_t mtime = 0;
+            std::uint32_t crc = 0;
+        };
+
+        constexpr const char *manifestMagic = "neko-zip-manifest 1";
+
+        // Raw copies are only valid while the archive is written with the same entry settings
+        std::string manifestHeader(const CreateConfig &config) {
+            std::ostringstream oss;
+            oss << manifestMagic << " level=" << static_cast<int>(config.compressionLevel)
+                << " store=" << config.storeCompressedInputs
+                << " encryption=" << (config.password.empty() ? -1 : static_cast<int>(config.encryption));
+            return oss.str();
+        }
+
+        // Returns no records when the manifest is missing or was written with other settings
+        std::unordered_map<std::string, ManifestRecord> loadManifest(const std::string &path, const std::string &header) {
+            std::unordered_map<std::string, ManifestRecord> records;
+            std::ifstream in(path);
+            std::string line;
+            if (!in || !std::getline(in, line) || line != header)
+                return records;
+            // size \t mtime \t crc \t name, with the name last so it may contain any other character
+            while (std::getline(in, line)) {
+                std::istringstream fields(line);
+                ManifestRecord record;
+                std::string name;
+                if (fields >> record.size >> record.mtime >> std::hex >> record.crc && fields.get() == '\t' && std::getline(fields, name))
+                    records[name] = record;
+            }
+            return records;
+        }
+
+        void saveManifest(const std::string &path, const std::string &header, const std::vector<PendingFile> &files, const ZipIndex &index) {
+            std::ofstream out(path, std::ios::trunc);
+            out << header << '\n';
+            for (const auto &file : files) {
+                const ZipEntryInfo *entry = index.find(file.entryName);
+                if (!entry)
+                    continue;
+                out << file.size << '\t' << file.mtime << '\t' << std::hex << entry->crc << std::dec << '\t' << file.entryName << '\n';
+            }
+            if (!out)
+                throw ex::FileError("Failed to write manifest: " + path);
+        }
+
+        void createIncremental(const CreateConfig &config, const WriterSettings &settings, std::vector<PendingFile> &files, Progress &progress) {
+            const std::string manifestPath = config.manifestPath.empty() ? config.outputArchivePath + ".manifest" : config.manifestPath;
+            const std::string header = manifestHeader(config);
+            auto records = loadManifest(manifestPath, header);
+
+            std::unique_ptr<ZipReader> previous;
+            // The previous central directory is read once, so each lookup below is a hash probe
+            std::optional<ZipIndex> previousIndex;
+            if (!records.empty() && std::filesystem::exists(config.outputArchivePath)) {
+                try {
+                    previousIndex.emplace(config.outputArchivePath);
+                    previous = std::make_unique<ZipReader>();
+                    // Positions the reader once, so its entry info follows the zip handle's later seeks
+                    if (mz_zip_reader_open_file(previous->get(), config.outputArchivePath.c_str()) != MZ_OK ||
+                        mz_zip_reader_goto_first_entry(previous->get()) != MZ_OK)
+                        previous.reset();
+                } catch (const ex::FileError &) {
+                    previous.reset();
+                }
+            }
+            if (!previous)
+                records.clear();
+
+            for (auto &file : files) {
+                std::error_code ec;
+                file.mtime = static_cast<std::int64_t>(std::filesystem::last_write_time(file.sourcePath, ec).time_since_epoch().count());
+                auto it = records.find(file.entryName);
+                if (ec || it == records.end() || it->second.size != file.size)
+                    continue;
+                const ZipEntryInfo *entry = previousIndex->find(file.entryName);
+                // A touched but identical file is still reused, at the cost of one read
+                file.reuse = entry && (it->second.mtime == file.mtime || crc32OfFile(file.sourcePath) == it->second.crc);
+                if (file.reuse)
+                    file.previousEntry = entry->centralDirOffset;
+            }
+            // Releases the index's mapping before the archive is replaced
+            previousIndex.reset();
+
+            // The previous archive is read while the new one is written, so write beside it
+            const std::string tempPath = config.outputArchivePath + ".tmp";
+            {
+                ZipWriter writer;
+                if (mz_zip_writer_open_file(writer.get(), tempPath.c_str(), 0, 0) != MZ_OK)
+                    throw ex::FileError("Failed to open zip file for writing: " + tempPath);
+                configureWriter(writer.get(), config, settings);
+                writeFiles(writer.get(), previous ? previous->get() : nullptr, config, settings, files, progress);
+                writer.close();
+            }
+            previous.reset();
+            if (progress.cancelled()) {
+                // The previous archive and manifest stay valid
+                std::error_code ec;
+                std::filesystem::remove(tempPath, ec);
+                return;
+            }
+            std::filesystem::rename(tempPath, config.outputArchivePath);
+
+            saveManifest(manifestPath, header, files, ZipIndex(config.outputArchivePath));
+        }
+
+        // Streams every selected file entry of an in-memory archive, calling begin once before the chunks of each entry
+        void readEntries(std::span<const neko::uchar> archive, const ExtractConfig &config,
+                         const std::function<void(const std::string &)> &begin, const EntrySink &sink) {
+            ZipReader reader;
+            // The reader does not copy the buffer and only reads from it
+            if (mz_zip_reader_open_buffer(reader.get(), const_cast<neko::uchar *>(archive.data()), memoryLength(archive.size(), "Archive"), 0) != MZ_OK)
+                throw ex::FileError("Failed to open zip buffer for reading");
+
+            const util::pattern::CompiledPatternSet includes(config.includePaths, config.wildcardMode);
+            const util::pattern::CompiledPatternSet excludes(config.excludePaths, config.wildcardMode);
+
+            if (!config.password.empty()) {
+                mz_zip_reader_set_password(reader.get(), config.password.c_str());
+            }
+
+            std::vector<neko::uchar> buffer(extractBufferSize);
+            neko::int32 entry_status = mz_zip_reader_goto_first_entry(reader.get());
+            while (entry_status == MZ_OK) {
+                mz_zip_file *file_info = nullptr;
+                mz_zip_reader_entry_get_info(reader.get(), &file_info);
+
+                std::string filename = file_info && (file_info->filename) ? file_info->filename : "";
+                if (!filename.empty() && filename.back() != '/' && isSelected(includes, excludes, filename)) {
+                    if ((file_info->flag & MZ_ZIP_FLAG_ENCRYPTED) && config.password.empty())
+                        throw ex::FileError("Encrypted file requires password: " + filename);
+                    if (mz_zip_reader_entry_open(reader.get()) != MZ_OK)
+                        throw ex::FileError("Failed to open entry: " + filename);
+
+                    if (begin)
+                        begin(filename);
+                    bool reported = false;
+                    neko::int32 read = 0;
+                    while ((read = mz_zip_reader_entry_read(reader.get(), buffer.data(), static_cast<std::int32_t>(buffer.size()))) > 0) {
+                        sink(filename, std::span<const neko::uchar>(buffer.data(), static_cast<std::size_t>(read)));
+                        reported = true;
+                    }
+                    // Closing the entry also verifies the CRC
+                    neko::int32 err = mz_zip_reader_entry_close(reader.get());
+                    if (read < 0 || err != MZ_OK)
+                        throw ex::FileError("Failed to extract file: " + filename);
+                    if (!reported)
+                        sink(filename, {});
+                }
+                entry_status = mz_zip_reader_goto_next_entry(reader.get());
+            }
+        }
+    } // namespace
+
+    ArchiveSummary extract(const ExtractConfig &config) {
+        NEKO_FUNCTION_PROFILE_SCOPE(timer, "archive.zip.extract");
+        Progress progress(config.observer, config.stopToken);
+        // Shared by the worker readers, which all inflate from the same mapping
+        const util::fs::MappedFile archive = mapArchive(config.inputArchivePath);
         ZipReader reader;
-        neko::int32 err = mz_zip_reader_open_file(reader.get(), config.inputArchivePath.c_str());
-        if (err != MZ_OK)
+        if (!openArchive(reader.get(), archive, config.inputArchivePath))
             throw ex::FileError("Failed to open zip file for reading: " + config.inputArchivePath);
 
+        const util::pattern::CompiledPatternSet includes(config.includePaths, config.wildcardMode);
+        const util::pattern::CompiledPatternSet excludes(config.excludePaths, config.wildcardMode);
+
         if (!config.password.empty()) {
             mz_zip_reader_set_password(reader.get(), config.password.c_str());
         }
 
+        std::size_t threads = config.threads != 0 ? config.threads : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        void *zipHandle = nullptr;
+        mz_zip_reader_get_zip_handle(reader.get(), &zipHandle);
+
+        // Each directory is created once, no matter how many entries it contains
+        std::unordered_set<std::string> createdDirs;
+        auto ensureDirectory = [&createdDirs](const std::filesystem::path &dir) {
+            if (!dir.empty() && createdDirs.insert(utf8String(dir)).second)
+                std::filesystem::create_directories(dir);
+        };
+
+        std::vector<PlannedEntry> planned;
+        std::vector<char> buffer(extractBufferSize);
+
         neko::int32 entry_status = mz_zip_reader_goto_first_entry(reader.get());
-        while (entry_status == MZ_OK) {
+        while (entry_status == MZ_OK && !progress.cancelled()) {
             mz_zip_file *file_info = nullptr;
             mz_zip_reader_entry_get_info(reader.get(), &file_info);
 
             std::string filename = file_info && (file_info->filename) ? file_info->filename : "";
             // Process includePaths/excludePaths
-            bool skip = false;
-            if (util::pattern::matchAny(filename, config.excludePaths)) {
-                skip = true;
-            }
-            if (!config.includePaths.empty() && !util::pattern::matchAny(filename, config.includePaths)) {
-                skip = true;
-            }
-            if (!skip) {
-                std::string out_path = (std::filesystem::path(config.destDir) / filename).string();
+            if (isSelected(includes, excludes, filename)) {
+                std::string out_path = utf8String(utf8Path(config.destDir) / utf8Path(filename));
                 if (file_info && (file_info->flag & MZ_ZIP_FLAG_ENCRYPTED) && config.password.empty())
                     throw ex::FileError("Encrypted file requires password: " + filename);
 
-                if (file_info && file_info->filename[strlen(file_info->filename) - 1] == '/') {
-                    std::filesystem::create_directories(out_path);
+                if (!filename.empty() && filename.back() == '/') {
+                    ensureDirectory(utf8Path(out_path));
                 } else {
-                    if (std::filesystem::exists(out_path) && !config.overwrite) {
-                        // Skip existing file if overwrite is false
+                    if (config.overwrite == OverwritePolicy::never && std::filesystem::exists(utf8Path(out_path))) {
+                        // Skip existing file
                         entry_status = mz_zip_reader_goto_next_entry(reader.get());
                         continue;
                     }
-                    std::filesystem::create_directories(std::filesystem::path(out_path).parent_path());
-                    // Extract file
-                    err = mz_zip_reader_entry_save_file(reader.get(), out_path.c_str());
-                    if (err != MZ_OK)
-                        throw ex::FileError("Failed to extract file: " + filename);
+                    bool symlink = mz_zip_entry_is_symlink(zipHandle) == MZ_OK;
+                    // Only the size is compared here; the CRC comparison reads the file and is left to whoever extracts it
+                    bool sameSize = false;
+                    if (config.overwrite == OverwritePolicy::ifChanged && !symlink) {
+                        std::error_code ec;
+                        auto size = std::filesystem::file_size(utf8Path(out_path), ec);
+                        sameSize = !ec && static_cast<std::int64_t>(size) == file_info->uncompressed_size;
+                    }
+                    ensureDirectory(utf8Path(out_path).parent_path());
+                    PlannedEntry entry{mz_zip_get_entry(zipHandle), file_info->uncompressed_size, file_info->compressed_size,
+                                       filename, std::move(out_path), sameSize, file_info->crc};
+                    if (symlink) {
+                        // Symlinks are resolved by minizip-ng itself
+                        if (progress.start(entry.name, entry.compressedSize, entry.size)) {
+                            auto begin = Clock::now();
+                            neko::int32 err = mz_zip_reader_entry_save_file(reader.get(), entry.outPath.c_str());
+                            if (err != MZ_OK)
+                                throw ex::FileError("Failed to extract file: " + filename);
+                            progress.addTimes(Clock::now() - begin, {});
+                            progress.finish(entry.name, entry.compressedSize, entry.size, Clock::now() - begin);
+                        }
+                    } else if (threads > 1) {
+                        // Defer to the worker threads
+                        planned.push_back(std::move(entry));
+                    } else {
+                        saveEntryAt(zipHandle, entry, config.password, buffer, progress);
+                    }
                 }
             }
             entry_status = mz_zip_reader_goto_next_entry(reader.get());
         }
+
+        if (!planned.empty() && !progress.cancelled()) {
+            extractPlanned(config, archive, planned, threads, progress);
+        }
+        return progress.summary();
     }
 
-    void create(const CreateConfig &config) {
-        ZipWriter writer;
-        neko::int32 err = mz_zip_writer_open_file(writer.get(), config.outputArchivePath.c_str(), 0, 0);
-        if (err != MZ_OK)
-            throw ex::FileError("Failed to open zip file for writing: " + config.outputArchivePath);
+    ArchiveSummary create(const CreateConfig &config) {
+        NEKO_FUNCTION_PROFILE_SCOPE(timer, "archive.zip.create");
+        Progress progress(config.observer, config.stopToken);
+        const WriterSettings settings = writerSettings(config.compressionLevel);
+        std::vector<PendingFile> files = collectInputs(config);
+        if (config.incremental) {
+            createIncremental(config, settings, files, progress);
+            return progress.summary();
+        }
 
-        if (!config.password.empty()) {
-            mz_zip_writer_set_password(writer.get(), config.password.c_str());
-            switch (config.encryption) {
-                case ZipEncryption::AES256:
-                    mz_zip_writer_set_aes(writer.get(), 1);
-                    break;
-                case ZipEncryption::ZipCrypto:
-                default:
-                    mz_zip_writer_set_aes(writer.get(), 0);
-                    break;
+        {
+            ZipWriter writer;
+            neko::int32 err = mz_zip_writer_open_file(writer.get(), config.outputArchivePath.c_str(), 0, 0);
+            if (err != MZ_OK)
+                throw ex::FileError("Failed to open zip file for writing: " + config.outputArchivePath);
+            configureWriter(writer.get(), config, settings);
+            writeFiles(writer.get(), nullptr, config, settings, files, progress);
+            writer.close();
+        }
+        if (progress.cancelled()) {
+            std::error_code ec;
+            std::filesystem::remove(config.outputArchivePath, ec);
+        }
+        return progress.summary();
+    }
+
+    std::future<ArchiveSummary> extractAsync(ExtractConfig config) {
+        return util::pool::defaultPool().submit([config = std::move(config)] { return extract(config); });
+    }
+
+    std::future<ArchiveSummary> createAsync(CreateConfig config) {
+        return util::pool::defaultPool().submit([config = std::move(config)] { return create(config); });
+    }
+
+    void extract(std::span<const neko::uchar> archive, const ExtractConfig &config, const EntrySink &sink) {
+        readEntries(archive, config, nullptr, sink);
+    }
+
+    void extract(const ReadCallback &read, const ExtractConfig &config, const EntrySink &sink) {
+        std::vector<neko::uchar> archive;
+        std::size_t size = 0;
+        while (true) {
+            archive.resize(size + extractBufferSize);
+            std::size_t got = read(archive.data() + size, extractBufferSize);
+            if (got == 0)
+                break;
+            size += std::min<std::size_t>(got, extractBufferSize);
+        }
+        archive.resize(size);
+        readEntries(archive, config, nullptr, sink);
+    }
+
+    std::vector<MemoryEntry> extractToMemory(std::span<const neko::uchar> archive, const ExtractConfig &config) {
+        std::vector<MemoryEntry> entries;
+        readEntries(
+            archive, config,
+            [&entries](const std::string &name) { entries.push_back({name, {}}); },
+            [&entries](std::string_view, std::span<const neko::uchar> chunk) {
+                entries.back().data.insert(entries.back().data.end(), chunk.begin(), chunk.end());
+            });
+        return entries;
+    }
+
+    std::vector<neko::uchar> create(std::span<const MemoryFile> files, const CreateConfig &config) {
+        MemoryStream stream;
+        {
+            ZipWriter writer;
+            if (mz_zip_writer_open(writer.get(), stream.get(), 0) != MZ_OK)
+                throw ex::Runtime("Failed to open in-memory zip writer");
+            const WriterSettings settings = writerSettings(config.compressionLevel);
+            configureWriter(writer.get(), config, settings);
+
+            const std::time_t now = std::time(nullptr);
+            for (const auto &file : files) {
+                const std::int32_t length = memoryLength(file.data.size(), file.name);
+                bool store = settings.method == MZ_COMPRESS_METHOD_STORE ||
+                             (config.storeCompressedInputs && isCompressedFormat(util::detect::identifyFileType(std::as_bytes(file.data), util::string::getExtensionName(file.name))));
+
+                mz_zip_file file_info = {};
+                file_info.filename = file.name.c_str();
+                file_info.modified_date = now;
+                file_info.version_madeby = MZ_VERSION_MADEBY;
+                file_info.compression_method = store ? MZ_COMPRESS_METHOD_STORE : settings.method;
+                file_info.flag = MZ_ZIP_FLAG_UTF8;
+                if (!config.password.empty())
+                    file_info.flag |= MZ_ZIP_FLAG_ENCRYPTED;
+
+                if (mz_zip_writer_add_buffer(writer.get(), const_cast<neko::uchar *>(file.data.data()), length, &file_info) != MZ_OK)
+                    throw ex::FileError("Failed to add buffer: " + file.name + " to in-memory zip");
             }
+            writer.close();
         }
 
-        for (const auto &input : config.inputPaths) {
-            if (std::filesystem::is_directory(input)) {
-                auto inputAbs = std::filesystem::absolute(input);
-                auto baseParent = inputAbs.parent_path();
-                for (const auto &p : std::filesystem::recursive_directory_iterator(input)) {
-                    if (!std::filesystem::is_regular_file(p))
-                        continue;
-                    std::string filePath = std::filesystem::relative(p.path(), baseParent).string();
-                    if (util::pattern::matchAny(filePath, config.excludePaths))
-                        continue;
-                    err = mz_zip_writer_add_file(writer.get(), p.path().string().c_str(), filePath.c_str());
-                    if (err != MZ_OK)
-                        throw ex::FileError("Failed to add file: " + filePath + " in zip: " + config.outputArchivePath);
-                }
-            } else {
-                std::string filePath = std::filesystem::path(input).filename().string();
-                if (util::pattern::matchAny(filePath, config.excludePaths))
-                    continue;
-                err = mz_zip_writer_add_file(writer.get(), input.c_str(), filePath.c_str());
-                if (err != MZ_OK)
-                    throw ex::FileError("Failed to add file: " + filePath + " in zip: " + config.outputArchivePath);
+        auto data = stream.contents();
+        if (data.empty())
+            throw ex::FileError("Failed to finalize in-memory zip");
+        return data;
+    }
+
+    // Owns idle reader handles on the archive, handed out to one reading thread at a time
+    struct ZipIndex::ReaderPool {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ZipReader>> idle;
+        // Every reader reads from this one mapping
+        util::fs::MappedFile archive;
+    };
+
+    ZipIndex::ZipIndex(std::string archivePath, std::string password)
+        : archivePath(std::move(archivePath)), password(std::move(password)), readers(std::make_unique<ReaderPool>()) {
+        readers->archive = mapArchive(this->archivePath);
+        auto reader = std::make_unique<ZipReader>();
+        if (!openArchive(reader->get(), readers->archive, this->archivePath))
+            throw ex::FileError("Failed to open zip file for reading: " + this->archivePath);
+        void *zipHandle = nullptr;
+        mz_zip_reader_get_zip_handle(reader->get(), &zipHandle);
+
+        neko::int32 entry_status = mz_zip_goto_first_entry(zipHandle);
+        while (entry_status == MZ_OK) {
+            mz_zip_file *file_info = nullptr;
+            if (mz_zip_entry_get_info(zipHandle, &file_info) == MZ_OK && file_info && file_info->filename) {
+                ZipEntryInfo info;
+                info.name = file_info->filename;
+                info.centralDirOffset = mz_zip_get_entry(zipHandle);
+                info.localHeaderOffset = file_info->disk_offset;
+                info.compressedSize = file_info->compressed_size;
+                info.uncompressedSize = file_info->uncompressed_size;
+                info.crc = file_info->crc;
+                info.flag = file_info->flag;
+                info.compressionMethod = file_info->compression_method;
+                info.modified = file_info->modified_date;
+                entryTable.push_back(std::move(info));
+            }
+            entry_status = mz_zip_goto_next_entry(zipHandle);
+        }
+        if (entry_status != MZ_END_OF_LIST)
+            throw ex::FileError("Failed to read central directory: " + this->archivePath);
+
+        // Stable, so a duplicated name keeps its first occurrence in the lookup
+        std::stable_sort(entryTable.begin(), entryTable.end(), [](const ZipEntryInfo &a, const ZipEntryInfo &b) {
+            return a.name < b.name;
+        });
+        lookup.reserve(entryTable.size());
+        for (std::size_t i = 0; i < entryTable.size(); ++i) {
+            lookup.emplace(entryTable[i].name, i);
+        }
+
+        readers->idle.push_back(std::move(reader));
+    }
+
+    ZipIndex::~ZipIndex() = default;
+    ZipIndex::ZipIndex(ZipIndex &&) noexcept = default;
+    ZipIndex &ZipIndex::operator=(ZipIndex &&) noexcept = default;
+
+    const ZipEntryInfo *ZipIndex::find(std::string_view name) const noexcept {
+        auto it = lookup.find(name);
+        return it != lookup.end() ? &entryTable[it->second] : nullptr;
+    }
+
+    std::vector<neko::uchar> ZipIndex::read(std::string_view name) const {
+        const ZipEntryInfo *entry = find(name);
+        if (!entry)
+            throw ex::FileError("Entry not found: " + std::string(name) + " in zip: " + archivePath);
+        return read(*entry);
+    }
+
+    std::vector<neko::uchar> ZipIndex::read(const ZipEntryInfo &entry) const {
+        std::unique_ptr<ZipReader> reader;
+        {
+            std::lock_guard<std::mutex> lock(readers->mutex);
+            if (!readers->idle.empty()) {
+                reader = std::move(readers->idle.back());
+                readers->idle.pop_back();
             }
         }
+        if (!reader) {
+            reader = std::make_unique<ZipReader>();
+            if (!openArchive(reader->get(), readers->archive, archivePath))
+                throw ex::FileError("Failed to open zip file for reading: " + archivePath);
+        }
+
+        void *zipHandle = nullptr;
+        mz_zip_reader_get_zip_handle(reader->get(), &zipHandle);
+        if (entry.isEncrypted() && password.empty())
+            throw ex::FileError("Encrypted file requires password: " + entry.name);
+        if (mz_zip_goto_entry(zipHandle, entry.centralDirOffset) != MZ_OK ||
+            mz_zip_entry_read_open(zipHandle, 0, password.empty() ? nullptr : password.c_str()) != MZ_OK)
+            throw ex::FileError("Failed to open entry: " + entry.name);
+
+        std::vector<neko::uchar> data(static_cast<std::size_t>(entry.uncompressedSize));
+        std::size_t filled = 0;
+        neko::int32 read = 0;
+        while (filled < data.size() &&
+               (read = mz_zip_entry_read(zipHandle, data.data() + filled, memoryLength(std::min<std::size_t>(data.size() - filled, extractBufferSize), entry.name))) > 0) {
+            filled += static_cast<std::size_t>(read);
+        }
+        // Closing the entry also verifies the CRC
+        neko::int32 err = mz_zip_entry_close(zipHandle);
+        if (read < 0 || err != MZ_OK || filled != data.size())
+            throw ex::FileError("Failed to read entry: " + entry.name + " in zip: " + archivePath);
+
+        std::lock_guard<std::mutex> lock(readers->mutex);
+        readers->idle.push_back(std::move(reader));
+        return data;
     }
 
 } // namespace neko::archive::zip
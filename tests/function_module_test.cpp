@@ -286,8 +286,28 @@ TEST_F(HashModuleTest, DifferentInputs) {
     EXPECT_NE(hash1, hash2);
 }
 
+TEST_F(HashModuleTest, IncrementalHasher) {
+    using namespace neko::util::hash;
+    Hasher hasher(Algorithm::sha256);
+    hasher.update("te").update("st");
+    EXPECT_EQ(hasher.finalize(), digest("test", Algorithm::sha256));
+}
+
 #endif // NEKO_FUNCTION_ENABLE_HASH
 
+class BuiltinHashModuleTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(BuiltinHashModuleTest, KnownVectors) {
+    using namespace neko::util::hash;
+    EXPECT_EQ(digest("123456789", Algorithm::crc32), "cbf43926");
+    EXPECT_EQ(digest("", Algorithm::xxh3_64), "2d06800538d394c2");
+    EXPECT_EQ(digest("abc", Algorithm::blake3), "6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85");
+}
+
 // ============================================================================
 // Archiver Tests (Module, conditional compilation)
 // ============================================================================
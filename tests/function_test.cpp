@@ -5,21 +5,39 @@
  */
 
 #include <gtest/gtest.h>
+#include <neko/function/base64.hpp>
 #include <neko/function/utilities.hpp>
 #include <neko/function/uuid.hpp>
+#include <neko/function/walker.hpp>
+#include <neko/function/mappedFile.hpp>
 #include <neko/function/detectFileType.hpp>
 #include <neko/function/pattern.hpp>
-
-#ifdef NEKO_FUNCTION_ENABLE_HASH
+#include <neko/function/pipeline.hpp>
 #include <neko/function/hash.hpp>
-#endif
+#include <neko/function/profile.hpp>
+#include <neko/function/threadPool.hpp>
 
 #ifdef NEKO_FUNCTION_ENABLE_ARCHIVE
 #include <neko/function/archive.hpp>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
 #include <fstream>
 #include <filesystem>
+#include <future>
+#include <list>
+#include <numeric>
+#include <random>
+#include <regex>
+#include <span>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 
 // ============================================================================
 // String Utilities Tests
@@ -60,6 +78,45 @@ TEST_F(StringUtilitiesTest, GetExtension) {
     EXPECT_EQ(ext, "txt");
 }
 
+TEST_F(StringUtilitiesTest, AsciiCaseAndExtensionViews) {
+    using namespace neko::util::string;
+    static_assert(toLowerAscii('Q') == 'q' && toUpperAscii('q') == 'Q' && toLowerAscii('1') == '1');
+    static_assert(equalsIgnoreCase("PnG", "png") && !equalsIgnoreCase("png", "pn"));
+    static_assert(getExtensionView("textures/Stone.PNG") == "PNG");
+    static_assert(matchExtensionName("/path/to/file.TXT", "txt"));
+    EXPECT_EQ(toLowerAscii(std::string_view("MiXeD-\xC4")), "mixed-\xC4");
+    EXPECT_EQ(toUpperAscii(std::string_view("abc.png")), "ABC.PNG");
+
+    // Same rules as std::filesystem::path::extension()
+    for (std::string path : {"a.txt", "archive.tar.gz", "dir.d/file", ".bashrc", "file.", "noext", "..", "/x/.hidden.cfg"}) {
+        auto expected = std::filesystem::path(path).extension().string();
+        EXPECT_EQ(getExtensionView(path), expected.empty() ? "" : expected.substr(1)) << path;
+    }
+    EXPECT_EQ(getExtensionName("archive.TAR.GZ"), "gz");
+    EXPECT_EQ(getExtensionName("archive.TAR.GZ", true), "GZ");
+    EXPECT_FALSE(matchExtensionName("file.txt", "TXT", true));
+    EXPECT_TRUE(matchExtensionNames("doc.pdF", {"txt", "md", "pdf"}));
+    EXPECT_FALSE(matchExtensionNames("noext", {"txt", "md"}));
+}
+
+TEST_F(StringUtilitiesTest, ExtensionSet) {
+    using namespace neko::util::string;
+    const ExtensionSet images({"png", ".JPG", "jpeg", ""});
+    EXPECT_EQ(images.size(), 3u);
+    EXPECT_TRUE(images.matches("textures/Stone.PNG"));
+    EXPECT_TRUE(images.matches("photo.jpg"));
+    EXPECT_TRUE(images.contains("JPEG"));
+    EXPECT_FALSE(images.matches("notes.txt"));
+    EXPECT_FALSE(images.matches("png"));
+    EXPECT_FALSE(images.matches(".png"));
+
+    ExtensionSet exact(true);
+    exact.insert(".Log");
+    EXPECT_TRUE(exact.matches("app.Log"));
+    EXPECT_FALSE(exact.matches("app.log"));
+    EXPECT_TRUE(ExtensionSet().empty());
+}
+
 TEST_F(StringUtilitiesTest, UnixPathConversion) {
     using namespace neko::util::string;
     auto unixPath = convertToUnixPath<std::string>("C:\\test\\file.txt");
@@ -84,6 +141,53 @@ TEST(PipeOperatorTest, LambdaUtility) {
     EXPECT_EQ(stringResult, "\"hello\"");
 }
 
+TEST(PipelineTest, LazyStages) {
+    using namespace neko::ops::pipeline;
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+
+    int calls = 0;
+    auto firstEven = values | filter([](int x) { return x % 2 == 0; }) | map([&](int x) { ++calls; return x * 10; }) | take(3) | collect();
+    EXPECT_EQ(firstEven, (std::vector<int>{0, 20, 40}));
+    EXPECT_EQ(calls, 3); // Only the taken elements are mapped
+
+    std::vector<std::vector<int>> chunks;
+    for (auto part : values | take(7) | chunk(3)) {
+        chunks.emplace_back(part.begin(), part.end());
+    }
+    EXPECT_EQ(chunks, (std::vector<std::vector<int>>{{0, 1, 2}, {3, 4, 5}, {6}}));
+
+    int sum = 0;
+    std::vector<int>{1, 2, 3} | map([](int x) { return x * x; }) | foreach([&](int x) { sum += x; });
+    EXPECT_EQ(sum, 14);
+}
+
+TEST(PipelineTest, ParallelStages) {
+    using namespace neko::ops::pipeline;
+    std::vector<int> values(10000);
+    std::iota(values.begin(), values.end(), 0);
+
+    std::atomic<long long> sum{0};
+    values | filter([](int x) { return x % 3 == 0; }) | parallel(4) | map([](int x) { return x * 2LL; }) | foreach([&](long long x) { sum += x; });
+    EXPECT_EQ(sum.load(), 33336666LL);
+
+    // collect keeps the upstream order whatever the batch size
+    auto squares = values | parallel(8, 7) | map([](int x) { return static_cast<long long>(x) * x; }) | collect();
+    ASSERT_EQ(squares.size(), values.size());
+    EXPECT_EQ(squares[9999], 99980001LL);
+    EXPECT_TRUE(std::is_sorted(squares.begin(), squares.end()));
+
+    std::list<std::string> names{"a.zip", "b.txt", "c.zip"};
+    auto zips = names | filter([](const std::string &name) { return name.ends_with(".zip"); }) | parallel(2) | collect();
+    EXPECT_EQ(zips, (std::vector<std::string>{"a.zip", "c.zip"}));
+
+    EXPECT_THROW(values | parallel(3) | foreach([](int x) {
+                     if (x == 5000)
+                         throw std::runtime_error("stop");
+                 }),
+                 std::runtime_error);
+}
+
 // ============================================================================
 // Logic Utilities Tests
 // ============================================================================
@@ -163,6 +267,270 @@ TEST_F(Base64Test, EncodeDecodeRoundTrip) {
     EXPECT_EQ(decoded, original);
 }
 
+TEST_F(Base64Test, BufferApiAndStrictDecode) {
+    using namespace neko::util::base64;
+    EXPECT_EQ(encodedSize(5), 8u);
+    EXPECT_EQ(decodedSize("SGVsbG8="), 5u);
+    EXPECT_EQ(decodedSize("SGVsbG8"), 5u);
+
+    std::array<char, 8> out{};
+    std::string_view hello = "Hello";
+    EXPECT_EQ(encode(std::as_bytes(std::span(hello.data(), hello.size())), out), 8u);
+    EXPECT_EQ(std::string_view(out.data(), out.size()), "SGVsbG8=");
+    std::array<char, 4> small{};
+    EXPECT_THROW(encode(std::as_bytes(std::span(hello.data(), hello.size())), small), neko::ex::InvalidArgument);
+
+    EXPECT_EQ(decode("SGVsbG8=").value_or(""), "Hello");
+    EXPECT_EQ(decode("SGVsbG8").value_or(""), "Hello");
+    EXPECT_FALSE(decode("SGV*bG8=").has_value());
+    EXPECT_FALSE(decode("SGVsb").has_value());
+    EXPECT_FALSE(decode("SG=sbG8=").has_value());
+    // The lenient decoder keeps the valid prefix
+    EXPECT_EQ(base64Decode("SGVsbG8*garbage"), "Hello");
+}
+
+TEST_F(Base64Test, KernelsMatchScalar) {
+    using namespace neko::util::base64;
+    namespace d = neko::util::base64::detail;
+    std::vector<d::Kernel> kernels{d::Kernel::scalar, d::detectKernel()};
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    if (d::detectKernel() == d::Kernel::avx2)
+        kernels.push_back(d::Kernel::ssse3);
+#endif
+    std::mt19937 rng(42);
+    for (std::size_t size = 0; size <= 300; ++size) {
+        std::vector<unsigned char> input(size);
+        for (auto &b : input)
+            b = static_cast<unsigned char>(rng());
+        for (const d::Alphabet *alphabet : {&d::standardAlphabet, &d::urlAlphabet}) {
+            std::string expected(encodedSize(size), '\0');
+            d::encodeTo(d::Kernel::scalar, input.data(), size, expected.data(), *alphabet, true);
+            for (auto kernel : kernels) {
+                std::string encoded(encodedSize(size), '\0');
+                EXPECT_EQ(d::encodeTo(kernel, input.data(), size, encoded.data(), *alphabet, true), encoded.size());
+                ASSERT_EQ(encoded, expected) << "size " << size;
+                std::vector<unsigned char> decoded(decodedSize(encoded));
+                auto written = d::decodeTo(kernel, encoded, decoded.data(), decoded.size(), *alphabet);
+                ASSERT_TRUE(written.has_value());
+                EXPECT_EQ(*written, size);
+                EXPECT_EQ(decoded, input);
+                if (size >= 3) {
+                    // An invalid character anywhere must be rejected by every kernel
+                    std::string broken = encoded;
+                    broken[rng() % (size / 3 * 4)] = static_cast<char>(0x80 | rng());
+                    EXPECT_FALSE(d::decodeTo(kernel, broken, decoded.data(), decoded.size(), *alphabet).has_value());
+                }
+            }
+        }
+    }
+}
+
+TEST_F(Base64Test, UrlVariant) {
+    using namespace neko::util::base64;
+    const std::string bytes = "\xfb\xff";
+    EXPECT_EQ(encode(bytes), "+/8=");
+    EXPECT_EQ(encode(bytes, Variant::url), "-_8=");
+    EXPECT_EQ(encode(bytes, Variant::urlUnpadded), "-_8");
+    EXPECT_EQ(encodedSize(2, Variant::urlUnpadded), 3u);
+    EXPECT_EQ(decode("-_8", Variant::url).value_or(""), bytes);
+    EXPECT_EQ(decode("-_8=", Variant::urlUnpadded).value_or(""), bytes);
+    EXPECT_FALSE(decode("+/8=", Variant::url).has_value());
+    EXPECT_FALSE(decode("-_8=").has_value());
+}
+
+TEST_F(Base64Test, StreamingMatchesBatch) {
+    using namespace neko::util::base64;
+    std::mt19937 rng(7);
+    std::string input(10000, '\0');
+    for (auto &c : input)
+        c = static_cast<char>(rng());
+
+    for (Variant variant : {Variant::standard, Variant::urlUnpadded}) {
+        for (std::size_t size : {0u, 1u, 2u, 3u, 100u, 10000u}) {
+            const std::string_view data(input.data(), size);
+            const std::string expected = encode(data, variant);
+
+            Encoder encoder(variant);
+            std::string encoded;
+            for (std::size_t pos = 0; pos < size;) {
+                const std::size_t n = std::min<std::size_t>(rng() % 70, size - pos);
+                encoded += encoder.update(data.substr(pos, n));
+                pos += n;
+            }
+            encoded += encoder.finish();
+            ASSERT_EQ(encoded, expected);
+
+            // Split the text anywhere, including between padding characters
+            Decoder decoder(variant);
+            std::string decoded;
+            for (std::size_t pos = 0; pos < encoded.size();) {
+                const std::size_t n = std::min<std::size_t>(rng() % 5 + (rng() % 2 ? 0 : 90), encoded.size() - pos);
+                auto part = decoder.update(std::string_view(encoded).substr(pos, n));
+                ASSERT_TRUE(part.has_value());
+                decoded += *part;
+                pos += n;
+            }
+            auto tail = decoder.finish();
+            ASSERT_TRUE(tail.has_value());
+            decoded += *tail;
+            EXPECT_EQ(decoded, data);
+        }
+    }
+
+    Decoder decoder;
+    EXPECT_TRUE(decoder.update("SGVsbG8").has_value());
+    EXPECT_FALSE(decoder.update("=A").has_value());
+    EXPECT_FALSE(decoder.finish().has_value());
+    EXPECT_TRUE(decoder.update("SGVsbG8=").has_value());
+    EXPECT_TRUE(decoder.finish().has_value());
+    EXPECT_TRUE(decoder.update("SGVsb").has_value());
+    EXPECT_FALSE(decoder.update("=").has_value());
+
+    std::istringstream in(input);
+    std::ostringstream out;
+    EXPECT_EQ(encode(in, out), encodedSize(input.size()));
+    EXPECT_EQ(out.str(), encode(input));
+    std::istringstream text(out.str());
+    std::ostringstream raw;
+    EXPECT_EQ(decode(text, raw).value_or(0), input.size());
+    EXPECT_EQ(raw.str(), input);
+}
+
+// ============================================================================
+// Random Tests
+// ============================================================================
+
+TEST(RandomTest, EngineAndUnbiasedDraws) {
+    using namespace neko::util::random;
+    Xoshiro256 gen(42);
+    EXPECT_EQ(gen(), 0x15780b2e0c2ec716ull);
+    EXPECT_EQ(gen(), 0x6104d9866d113a7eull);
+    EXPECT_EQ(gen(), 0xae17533239e499a1ull);
+
+    std::array<int, 6> counts{};
+    for (int i = 0; i < 60000; ++i) {
+        auto v = uniform(gen, 6);
+        ASSERT_LT(v, 6u);
+        ++counts[v];
+    }
+    for (int c : counts)
+        EXPECT_NEAR(c, 10000, 600);
+
+    // Every character of a 62-symbol alphabet shows up evenly, even though 10 come from each draw
+    std::string text(62000, '\0');
+    fillChars(gen, text, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789");
+    std::unordered_map<char, int> seen;
+    for (char c : text)
+        ++seen[c];
+    EXPECT_EQ(seen.size(), 62u);
+    for (auto &[c, n] : seen)
+        EXPECT_NEAR(n, 1000, 200) << c;
+}
+
+TEST(RandomTest, StringsNumbersAndFill) {
+    using namespace neko::util::random;
+    auto hex = randomHex(33);
+    EXPECT_EQ(hex.size(), 33u);
+    EXPECT_EQ(hex.find_first_not_of("0123456789abcdef"), std::string::npos);
+    auto token = generateRandomString(40, "ABC", Source::secure);
+    EXPECT_EQ(token.size(), 40u);
+    EXPECT_EQ(token.find_first_not_of("ABC"), std::string::npos);
+    EXPECT_EQ(generateRandomString(5, "x"), "xxxxx");
+    EXPECT_THROW(generateRandomString(5, ""), std::invalid_argument);
+    EXPECT_NE(randomHex(32, Source::secure), randomHex(32, Source::secure));
+
+    for (int i = 0; i < 1000; ++i) {
+        auto n = randomNDigitNumber(3, 5);
+        EXPECT_GE(n, 100u);
+        EXPECT_LE(n, 99999u);
+    }
+    EXPECT_GE(randomNDigitNumber(20, 20), 10000000000000000000ull);
+    EXPECT_THROW(randomNDigitNumber(0, 3), std::invalid_argument);
+    EXPECT_THROW(randomNDigitNumber(4, 3), std::invalid_argument);
+
+    for (Source source : {Source::fast, Source::secure}) {
+        std::vector<std::byte> bytes(1027);
+        fill(bytes, source);
+        EXPECT_GT(std::count_if(bytes.begin(), bytes.end(), [](std::byte b) { return b != std::byte{0}; }), 900);
+        std::array<std::uint64_t, 4> words{};
+        fill(words, source);
+        EXPECT_NE(words[0], words[1]);
+        EXPECT_LT(uniform(10, source), 10u);
+    }
+}
+
+// ============================================================================
+// Time Tests
+// ============================================================================
+
+namespace {
+    // The regex-based parser this library used before, kept as the reference behavior
+    std::optional<std::time_t> regexParseToUTCTime(const std::string &iso8601) {
+        std::tm tmResult = {};
+        std::regex r(R"((\d{4})-(\d{2})-(\d{2})[Tt](\d{2}):(\d{2}):(\d{2})(?:\.\d+)?(Z|([+-])(\d{2}):?(\d{2}))?)");
+        std::smatch m;
+        if (!std::regex_match(iso8601, m, r))
+            return std::nullopt;
+        tmResult.tm_year = std::stoi(m[1]) - 1900;
+        tmResult.tm_mon = std::stoi(m[2]) - 1;
+        tmResult.tm_mday = std::stoi(m[3]);
+        tmResult.tm_hour = std::stoi(m[4]);
+        tmResult.tm_min = std::stoi(m[5]);
+        tmResult.tm_sec = std::stoi(m[6]);
+        std::time_t t = neko::util::time::toUtcTimeT(tmResult);
+        if (m[8].matched)
+            t -= (m[8] == "+" ? 1 : -1) * (std::stoi(m[9]) * 3600 + std::stoi(m[10]) * 60);
+        return t;
+    }
+} // namespace
+
+TEST(TimeTest, ParseMatchesRegexParser) {
+    using namespace neko::util::time;
+    const std::vector<std::string> inputs = {
+        "2024-06-07T15:04:05Z", "2024-06-07t15:04:05", "2024-06-07T15:04:05.123Z", "2024-06-07T15:04:05.1234567891+05:30",
+        "2024-06-07T15:04:05+0530", "2024-06-07T15:04:05-08:00", "1969-12-31T23:59:59Z", "2000-02-29T00:00:00Z",
+        "2024-00-10T10:00:00Z", "2024-13-01T00:00:00Z", "2024-01-32T25:61:61Z", "2024-01-00T00:00:00Z", "0000-00-00T00:00:00Z",
+        "9999-12-31T23:59:59Z", "2024-06-07 15:04:05Z", "2024-06-07T15:04:05z", "2024-06-07T15:04:05.Z", "2024-06-07T15:04",
+        "2024-06-07T15:04:05+05:3", "2024-06-07T15:04:05+05", "2024-06-07T15:04:05+05:300", "24-06-07T15:04:05Z",
+        "2024-6-07T15:04:05Z", " 2024-06-07T15:04:05Z", "2024-06-07T15:04:05ZZ", "2024-06-07T15:04:05.5.5Z", ""};
+    for (const auto &input : inputs) {
+        EXPECT_EQ(parseToUTCTime(input), regexParseToUTCTime(input)) << input;
+    }
+}
+
+TEST(TimeTest, FractionalSecondsAndFormatting) {
+    using namespace neko::util::time;
+    using namespace std::chrono;
+    auto t = parseIso8601("2024-06-07T15:04:05.123456789+01:00");
+    ASSERT_TRUE(t.has_value());
+    EXPECT_EQ(t->time_since_epoch().count() % 1000000000, 123456789);
+    static_assert(parseIso8601("1970-01-01T00:00:01.5Z") == UtcTime{1500ms});
+
+    EXPECT_EQ(formatIso8601(*t).value_or(""), "2024-06-07T14:04:05Z");
+    EXPECT_EQ(formatIso8601(*t, 3).value_or(""), "2024-06-07T14:04:05.123Z");
+    EXPECT_EQ(formatIso8601(*t, 9).value_or(""), "2024-06-07T14:04:05.123456789Z");
+    EXPECT_EQ(formatIso8601(UtcTime{-1s}).value_or(""), "1969-12-31T23:59:59Z");
+    std::array<char, 10> small{};
+    EXPECT_THROW(formatIso8601(*t, small), neko::ex::InvalidArgument);
+    EXPECT_THROW(formatIso8601(*t, 10), neko::ex::InvalidArgument);
+
+    // The strftime-free path must print the same as before
+    for (std::time_t s : {std::time_t{0}, std::time_t{951782400}, std::time_t{1717772645}, std::time_t{-86401}, std::time_t{253402300799}}) {
+        std::tm tm = toUtcTm(s);
+        std::array<char, 64> expected{};
+        std::strftime(expected.data(), expected.size(), "%Y-%m-%dT%H:%M:%SZ", &tm);
+        EXPECT_EQ(getUtcZTimeString(s).value_or(""), expected.data());
+    }
+    EXPECT_EQ(parseToUTCTimeString("2024-01-15T14:30:45+08:00").value_or(""), "2024-01-15T06:30:45Z");
+
+    const std::vector<std::string_view> batch = {"2024-06-07T15:04:05Z", "bad", "1970-01-01T00:00:00Z"};
+    auto results = parseIso8601(batch);
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_TRUE(results[0].has_value());
+    EXPECT_FALSE(results[1].has_value());
+    EXPECT_EQ(results[2], UtcTime{});
+}
+
 // ============================================================================
 // UUID Tests
 // ============================================================================
@@ -190,6 +558,74 @@ TEST(UUIDTest, UUIDv4Uniqueness) {
     EXPECT_NE(uuid1, uuid2);
 }
 
+TEST(UUIDTest, UuidValueType) {
+    using namespace neko::util::uuid;
+    static_assert(sizeof(Uuid) == 16 && std::is_trivially_copyable_v<Uuid>);
+    static_assert(Uuid::parse("6ba7b810-9dad-11d1-80b4-00c04fd430c8") == Uuid::parse("{6BA7B810-9DAD-11D1-80B4-00C04FD430C8}"));
+    static_assert(Uuid::parse("6ba7b8109dad11d180b400c04fd430c8") == namespaceDns);
+    static_assert(Uuid::parse("6ba7b810-9dad-11d1-80b4-00c04fd430c8")->version() == 1);
+    static_assert(Uuid{}.isNil());
+
+    EXPECT_FALSE(Uuid::parse("6ba7b810-9dad-11d1-80b4-00c04fd430cg").has_value());
+    EXPECT_FALSE(Uuid::parse("6ba7b810-9dad-11d1-80b400c04fd430c8-").has_value());
+    EXPECT_FALSE(Uuid::parse("6ba7b810-9dad-11d1-80b4-00c04fd430c").has_value());
+    EXPECT_FALSE(Uuid::parse("{6ba7b810-9dad-11d1-80b4-00c04fd430c8").has_value());
+    EXPECT_EQ(namespaceUrl.toString(), "6ba7b811-9dad-11d1-80b4-00c04fd430c8");
+
+    Uuid id = Uuid::v4();
+    EXPECT_EQ(id.version(), 4);
+    EXPECT_EQ(id.bytes()[8] & 0xC0, 0x80);
+    EXPECT_EQ(Uuid::parse(id.toString()), id);
+    std::array<char, Uuid::stringSize> buffer{};
+    EXPECT_EQ(id.toChars(buffer.data()), buffer.data() + buffer.size());
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), id.toString());
+
+    std::unordered_map<Uuid, int> map;
+    map[id] = 1;
+    map[namespaceDns] = 2;
+    EXPECT_EQ(map.at(id), 1);
+    EXPECT_LT(namespaceDns, namespaceUrl);
+    EXPECT_EQ(uuidStringToBytes(namespaceDns.toString()), namespaceDns.bytes());
+}
+
+TEST(UUIDTest, UuidV7OrderedAndBulk) {
+    using namespace neko::util::uuid;
+    const auto before = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    std::vector<Uuid> ids(10000);
+    Uuid::v7(ids);
+    EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+    EXPECT_EQ(std::adjacent_find(ids.begin(), ids.end()), ids.end());
+    EXPECT_EQ(ids.front().version(), 7);
+    EXPECT_EQ(ids.back().bytes()[8] & 0xC0, 0x80);
+    EXPECT_GE(ids.front().unixMillis(), static_cast<std::uint64_t>(before));
+    EXPECT_LT(ids.back(), Uuid::v7());
+    const std::string first = uuidV7();
+    EXPECT_LT(first, uuidV7());
+
+    // Stamps are shared across threads, so every id is distinct and each thread sees increasing ids
+    std::vector<std::vector<Uuid>> perThread(4);
+    std::vector<std::thread> threads;
+    for (auto &out : perThread) {
+        threads.emplace_back([&out] {
+            for (int i = 0; i < 2000; ++i)
+                out.push_back(Uuid::v7());
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+    std::vector<Uuid> all;
+    for (auto &out : perThread) {
+        EXPECT_TRUE(std::is_sorted(out.begin(), out.end()));
+        all.insert(all.end(), out.begin(), out.end());
+    }
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(std::adjacent_find(all.begin(), all.end()), all.end());
+
+    std::vector<Uuid> random(1000);
+    Uuid::v4(random);
+    EXPECT_TRUE(std::all_of(random.begin(), random.end(), [](const Uuid &id) { return id.version() == 4; }));
+}
+
 // ============================================================================
 // Pattern Matching Tests
 // ============================================================================
@@ -213,6 +649,10 @@ TEST_F(PatternMatchingTest, ExtensionPattern) {
     EXPECT_TRUE(isExtensionPattern(".log"));
     EXPECT_FALSE(isExtensionPattern("*.txt"));
     EXPECT_FALSE(isExtensionPattern("file.txt"));
+    EXPECT_TRUE(matchExtension("logs/app.log", ".log"));
+    EXPECT_FALSE(matchExtension("logs/app.LOG", ".log"));
+    EXPECT_FALSE(matchExtension("logs/.log", ".log"));
+    EXPECT_FALSE(matchExtension("noext", "."));
 }
 
 TEST_F(PatternMatchingTest, WildcardMatching) {
@@ -222,6 +662,194 @@ TEST_F(PatternMatchingTest, WildcardMatching) {
     EXPECT_FALSE(matchWildcardPattern("file.txt", "*.log"));
 }
 
+TEST_F(PatternMatchingTest, GlobSyntax) {
+    using namespace neko::util::pattern;
+    EXPECT_TRUE(globMatch("main.cpp", "*.cpp"));
+    EXPECT_FALSE(globMatch("src/main.cpp", "*.cpp"));
+    EXPECT_TRUE(globMatch("src/a/b/main.cpp", "src/**/*.cpp"));
+    EXPECT_TRUE(globMatch("src/main.cpp", "src/**/*.cpp"));
+    EXPECT_TRUE(globMatch("a/b/c", "a/**"));
+    EXPECT_TRUE(globMatch("file1.log", "file?.log"));
+    EXPECT_FALSE(globMatch("file12.log", "file?.log"));
+    EXPECT_FALSE(globMatch("a/b", "a?b"));
+    EXPECT_TRUE(globMatch("img_b.png", "img_[abc].png"));
+    EXPECT_FALSE(globMatch("img_d.png", "img_[abc].png"));
+    EXPECT_TRUE(globMatch("v7", "v[0-9]"));
+    EXPECT_TRUE(globMatch("vx", "v[!0-9]"));
+    EXPECT_FALSE(globMatch("v5", "v[^0-9]"));
+    EXPECT_TRUE(globMatch("a*b", "a\\*b"));
+    EXPECT_FALSE(globMatch("axb", "a\\*b"));
+    EXPECT_TRUE(globMatch("[x", "[x"));
+    EXPECT_TRUE(globMatch("", "*"));
+    EXPECT_FALSE(globMatch("", "?"));
+
+    // Pathological for backtracking matchers, linear here
+    std::string text(20000, 'a');
+    EXPECT_FALSE(globMatch(text, "*a*a*a*a*a*a*a*a*a*a*b"));
+    EXPECT_TRUE(globMatch(text, "**a*a*a*a*a"));
+}
+
+TEST_F(PatternMatchingTest, WildcardModes) {
+    using namespace neko::util::pattern;
+    EXPECT_TRUE(matchWildcardPattern("lib/src/util.cpp", "src/*.cpp"));
+    EXPECT_FALSE(matchWildcardPattern("src/sub/deep.cpp", "src/*.cpp"));
+    EXPECT_FALSE(matchWildcardPattern("/abs/dir/sub/b.h", "/abs/dir/*.h"));
+    EXPECT_TRUE(matchWildcardPattern("/abs/dir/sub/b.h", "/abs/dir/*.h", WildcardMode::legacy));
+    EXPECT_TRUE(matchWildcardPattern("out/build1/a.o", "build*/"));
+    EXPECT_TRUE(matchAny("photo_1.jpg", {"photo_?.jpg"}));
+    EXPECT_FALSE(matchAny("photo_1.jpg", {"photo_?.jpg"}, WildcardMode::legacy));
+}
+
+TEST_F(PatternMatchingTest, CompiledPatternSetMatchesMatchAny) {
+    using namespace neko::util::pattern;
+    const std::vector<std::string> patterns = {
+        "*.txt", "file*.log", "src/*.cpp", "/abs/dir/*.h", "build*/", "**/test/*.cc", ".md", "cache/", "/root/logs/",
+        "user/abc.txt", "/root/exact.bin", "README", "./docs/guide.md"};
+    const std::vector<std::string> targets = {
+        "a.txt", ".txt", "dir/notes.txt", "file1.log", "x/file.log", "src/main.cpp", "lib/src/util.cpp",
+        "src/sub/deep.cpp", "/abs/dir/a.h", "/abs/dir/sub/b.h", "/abs/other/a.h", "doc.md", ".md",
+        "a/cache/x.bin", "cache/x.bin", "/root/logs", "/root/logs/today.log", "/root/logsx/a",
+        "home/user/abc.txt", "user/abc.txt", "superuser/abc.txt", "/root/exact.bin", "root/exact.bin",
+        "README", "pkg/README", "docs/guide.md", "a//b/../c.txt", "./README", "", "a/b/"};
+    for (auto mode : {WildcardMode::glob, WildcardMode::legacy}) {
+        const CompiledPatternSet compiled(patterns, mode);
+        for (const auto &target : targets) {
+            bool expected = false;
+            for (const auto &pattern : patterns) {
+                if (matchAny(target, {pattern}, mode)) {
+                    expected = true;
+                }
+                EXPECT_EQ(CompiledPatternSet({pattern}, mode).match(target), matchAny(target, {pattern}, mode)) << target << " ~ " << pattern;
+            }
+            EXPECT_EQ(compiled.match(target), expected) << target;
+        }
+    }
+    EXPECT_TRUE(CompiledPatternSet().empty());
+    EXPECT_FALSE(CompiledPatternSet().match("a.txt"));
+    EXPECT_TRUE(CompiledPatternSet({"*"}).match("any/path"));
+}
+
+TEST_F(PatternMatchingTest, MatchDirectoryIsConservative) {
+    using namespace neko::util::pattern;
+    const CompiledPatternSet excludes({"node_modules/", "/abs/out/", "build*/", "gen/**", "*.tmp", "src/*.cpp"});
+    EXPECT_TRUE(excludes.matchDirectory("root/node_modules"));
+    EXPECT_TRUE(excludes.matchDirectory("root/a/node_modules/sub"));
+    EXPECT_TRUE(excludes.matchDirectory("/abs/out"));
+    EXPECT_TRUE(excludes.matchDirectory("root/build-debug"));
+    EXPECT_TRUE(excludes.matchDirectory("root/x/gen"));
+    // The root component is never a directory-name match, as with match()
+    EXPECT_FALSE(excludes.matchDirectory("node_modules"));
+    EXPECT_FALSE(excludes.matchDirectory("root/src"));
+    EXPECT_FALSE(excludes.matchDirectory("root/generated"));
+    EXPECT_FALSE(CompiledPatternSet().matchDirectory("root/node_modules"));
+}
+
+// ============================================================================
+// Directory Walker Tests
+// ============================================================================
+
+TEST(WalkerTest, PrunesExcludedDirectoriesAndMatchesFullWalk) {
+    namespace fs = std::filesystem;
+    using neko::util::fs::listFiles;
+    namespace pattern = neko::util::pattern;
+    const fs::path root = "walker_test_tree";
+    fs::remove_all(root);
+    for (const char *dir : {"src/deep/er", "node_modules/pkg/lib", "a/node_modules/x", "build-out", "gen/code", "docs"})
+        fs::create_directories(root / dir);
+    for (const char *file : {"src/main.cpp", "src/deep/a.h", "src/deep/er/b.tmp", "src/deep/er/c.txt", "node_modules/pkg/lib/i.js",
+                             "a/node_modules/x/y.js", "a/keep.txt", "build-out/o.bin", "gen/code/g.cc", "docs/readme.md", "top.tmp"}) {
+        std::ofstream(root / file) << file;
+    }
+    const std::vector<std::string> patterns = {"node_modules/", "build*/", "gen/**", "*.tmp"};
+
+    // Reference: every file of a full recursive walk, filtered one by one
+    const pattern::CompiledPatternSet excludes(patterns);
+    std::vector<std::string> expected;
+    for (const auto &entry : fs::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file())
+            continue;
+        std::string relative = fs::relative(entry.path(), fs::absolute(root).parent_path()).generic_string();
+        if (!excludes.match(relative))
+            expected.push_back(relative);
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected.size(), 5u);
+
+    for (std::size_t threads : {1u, 4u, 0u}) {
+        auto files = listFiles(root, {patterns, threads});
+        std::vector<std::string> names;
+        for (const auto &file : files) {
+            names.push_back(file.relativePath);
+            EXPECT_EQ(file.size, file.relativePath.size() - root.string().size() - 1);
+        }
+        std::sort(names.begin(), names.end());
+        EXPECT_EQ(names, expected) << threads << " threads";
+    }
+
+    auto inside = listFiles(root / "src" / "");
+    ASSERT_FALSE(inside.empty());
+    EXPECT_EQ(inside.front().relativePath.find("src/"), std::string::npos);
+    EXPECT_THROW(listFiles("walker_missing_dir"), std::filesystem::filesystem_error);
+    fs::remove_all(root);
+}
+
+TEST(MappedFileTest, MappedBufferedAndStream) {
+    using namespace neko::util::fs;
+    const std::string large = "mapped_file_large.bin";
+    const std::string small = "mapped_file_small.txt";
+    std::string content(MappedFile::mapThreshold * 3 + 17, '\0');
+    for (std::size_t i = 0; i < content.size(); ++i)
+        content[i] = static_cast<char>(i * 31 % 251);
+    std::ofstream(large, std::ios::binary) << content;
+    std::ofstream(small, std::ios::binary) << "small file";
+
+    auto asString = [](std::span<const std::byte> bytes) {
+        return std::string(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    };
+
+    MappedFile mapped(large);
+    EXPECT_EQ(mapped.mode(), MappedFile::Mode::mapped);
+    EXPECT_EQ(asString(mapped.bytes()), content);
+    std::string joined;
+    EXPECT_EQ(mapped.forEachChunk(4096, [&](std::span<const std::byte> chunk) { joined += asString(chunk); }), content.size());
+    EXPECT_EQ(joined, content);
+
+    MappedFile moved = std::move(mapped);
+    EXPECT_FALSE(mapped.isOpen());
+    EXPECT_EQ(asString(moved.peek(8)), content.substr(0, 8));
+
+    MappedFile buffered(small);
+    EXPECT_EQ(buffered.mode(), MappedFile::Mode::buffered);
+    EXPECT_EQ(asString(buffered.bytes()), "small file");
+    EXPECT_EQ(asString(buffered.peek(100)), "small file");
+
+    std::error_code ec;
+    MappedFile missing("mapped_file_missing.bin", ec);
+    EXPECT_TRUE(ec);
+    EXPECT_FALSE(missing.isOpen());
+    EXPECT_THROW(MappedFile("mapped_file_missing.bin"), neko::ex::FileError);
+
+#if defined(__linux__)
+    // Reports size 0 but has content, so it is read as a stream; peeked bytes are delivered again
+    MappedFile stream("/proc/self/status");
+    EXPECT_EQ(stream.mode(), MappedFile::Mode::stream);
+    EXPECT_TRUE(stream.bytes().empty());
+    EXPECT_EQ(asString(stream.peek(5)), "Name:");
+    std::string status;
+    stream.forEachChunk(16, [&](std::span<const std::byte> chunk) { status += asString(chunk); });
+    EXPECT_EQ(status.rfind("Name:", 0), 0u);
+    EXPECT_NE(status.find("Pid:"), std::string::npos);
+#endif
+
+    // Hashing and detection read the same mapping
+    EXPECT_EQ(neko::util::hash::digest(moved, neko::util::hash::Algorithm::crc32), neko::util::hash::digest(content, neko::util::hash::Algorithm::crc32));
+    EXPECT_EQ(neko::util::hash::digestFile(large, neko::util::hash::Algorithm::xxh3_64), neko::util::hash::digest(content, neko::util::hash::Algorithm::xxh3_64));
+    EXPECT_EQ(neko::util::detect::identifyFileType(buffered), neko::util::detect::FileType::txt);
+
+    std::filesystem::remove(large);
+    std::filesystem::remove(small);
+}
+
 // ============================================================================
 // Validation Tests
 // ============================================================================
@@ -251,6 +879,96 @@ TEST(ValidationTest, ResolutionParsing) {
     EXPECT_FALSE(invalid.has_value());
 }
 
+// ============================================================================
+// File Type Detection Tests
+// ============================================================================
+
+TEST(FileTypeDetectionTest, MagicNumbers) {
+    using namespace neko::util::detect;
+    constexpr neko::uchar png[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A, 0};
+    static_assert(detail::findSignature(png, sizeof(png)) != nullptr);
+    static_assert(detail::findSignature(png, 4) == nullptr);
+
+    EXPECT_EQ(detail::typeByMagic(png, sizeof(png)), "PNG");
+    const neko::uchar zip[] = {0x50, 0x4B, 0x03, 0x04, 0x14};
+    EXPECT_EQ(detail::typeByMagic(zip, sizeof(zip)), "ZIP");
+    // Shares the first byte with MOV, matched in table order
+    const neko::uchar mp4[] = {0x00, 0x00, 0x00, 0x18, 0x66, 0x74, 0x79, 0x70};
+    EXPECT_EQ(detail::typeByMagic(mp4, sizeof(mp4)), "MP4");
+    const neko::uchar gz[] = {0x1F, 0x8B, 0x08};
+    EXPECT_EQ(detail::typeByMagic(gz, sizeof(gz)), "GZ");
+    const neko::uchar unknown[] = {0x01, 0x02, 0x03};
+    EXPECT_EQ(detail::typeByMagic(unknown, sizeof(unknown)), "Unknown");
+    EXPECT_EQ(detail::typeByMagic(unknown, 0), "Unknown");
+
+    EXPECT_EQ(detail::typeByExtension("jpeg"), "JPEG");
+    EXPECT_EQ(detail::typeByExtension("dll"), "DLL");
+    EXPECT_EQ(detail::typeByExtension("nope"), "Unknown");
+}
+
+TEST(FileTypeDetectionTest, BufferAndBatch) {
+    using namespace neko::util::detect;
+    const unsigned char gif[] = {'G', 'I', 'F', '8', '9', 'a'};
+    EXPECT_EQ(detectFileType(std::as_bytes(std::span(gif))), "GIF");
+    const unsigned char text[] = {'a', ',', 'b'};
+    EXPECT_EQ(detectFileType(std::as_bytes(std::span(text)), ".CSV"), "CSV");
+    EXPECT_EQ(detectFileType(std::as_bytes(std::span(text))), "Unknown");
+
+    const std::string dir = "test_detect_batch";
+    std::filesystem::create_directories(dir);
+    std::vector<std::string> paths;
+    for (int i = 0; i < 20; ++i) {
+        paths.push_back(dir + "/f" + std::to_string(i) + (i % 2 ? ".bin" : ".json"));
+        std::ofstream out(paths.back(), std::ios::binary);
+        if (i % 2)
+            out.write(reinterpret_cast<const char *>(gif), sizeof(gif));
+        else
+            out << "[1, 2]";
+    }
+    paths.push_back(dir + "/missing.png");
+
+    auto types = detectFileTypes(paths, 4);
+    ASSERT_EQ(types.size(), paths.size());
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(types[i], i % 2 ? "GIF" : "JSON") << paths[i];
+        EXPECT_EQ(types[i], detectFileType(paths[i], true));
+    }
+    EXPECT_EQ(types.back(), "Unknown");
+    std::filesystem::remove_all(dir);
+}
+
+TEST(FileTypeDetectionTest, FileTypeIdsAndSets) {
+    using namespace neko::util::detect;
+    static_assert(fileTypeFromName("7z") == FileType::sevenZip);
+    static_assert(fileTypeName(FileType::jpeg) == "JPEG");
+    static_assert(fileTypeFromName("nope") == FileType::unknown);
+
+    constexpr FileTypeSet images{FileType::png, FileType::jpeg, FileType::gif};
+    static_assert(images.contains(FileType::png) && !images.contains(FileType::zip));
+    static_assert(!images.contains(FileType::unknown));
+    EXPECT_TRUE((images | FileTypeSet{FileType::zip}).contains(FileType::zip));
+    EXPECT_TRUE((images & FileTypeSet{FileType::zip}).empty());
+
+    const unsigned char png[] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+    EXPECT_EQ(identifyFileType(std::as_bytes(std::span(png))), FileType::png);
+
+    const std::string path = "test_identify.png";
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(png), sizeof(png));
+    EXPECT_EQ(identifyFileType(path), FileType::png);
+    EXPECT_TRUE(isTargetFileType(path, images));
+    EXPECT_TRUE(isTargetFileType(path, {"png", "gif"}));
+    EXPECT_FALSE(isTargetFileType(path, {"png"}, true));
+    EXPECT_EQ(identifyFileType("test_identify_missing.png"), FileType::unknown);
+    EXPECT_FALSE(isTargetFileType("test_identify_missing.png", images));
+    EXPECT_EQ(identifyKnownFileType(path), FileType::png);
+    EXPECT_THROW(identifyKnownFileType("test_identify_missing.png"), neko::ex::FileError);
+
+    const std::vector<std::string> batch{path, "test_identify_missing.png"};
+    EXPECT_EQ(identifyFileTypes(batch), (std::vector<FileType>{FileType::png, FileType::unknown}));
+    EXPECT_TRUE(identifyFileTypes({}).empty());
+    std::filesystem::remove(path);
+}
+
 // ============================================================================
 // Hash Function Tests (conditional compilation)
 // ============================================================================
@@ -291,8 +1009,368 @@ TEST_F(HashTest, DifferentInputs) {
     EXPECT_NE(hash1, hash2);
 }
 
+TEST_F(HashTest, KnownDigest) {
+    using namespace neko::util::hash;
+    EXPECT_EQ(digest("test", Algorithm::md5), "098f6bcd4621d373cade4e832627b4f6");
+    EXPECT_EQ(digest("test", Algorithm::sha256), "9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08");
+}
+
+TEST_F(HashTest, IncrementalHasher) {
+    using namespace neko::util::hash;
+    Hasher hasher(Algorithm::sha256);
+    hasher.update("te").update("st");
+    EXPECT_EQ(hasher.finalize(), digest("test", Algorithm::sha256));
+
+    // Reuse after init
+    hasher.init();
+    hasher.update(std::string_view("test1"));
+    EXPECT_EQ(hasher.finalize(), digest("test1", Algorithm::sha256));
+}
+
+TEST_F(HashTest, StreamAndFileDigest) {
+    using namespace neko::util::hash;
+    std::string content(200000, 'x');
+    std::istringstream stream(content);
+    EXPECT_EQ(digest(stream, Algorithm::sha1, 4096), digest(content, Algorithm::sha1));
+
+    const std::string fileName = "test_hash_file.bin";
+    {
+        std::ofstream file(fileName, std::ios::binary);
+        file << content;
+    }
+    EXPECT_EQ(digestFile(fileName, Algorithm::sha1), digest(content, Algorithm::sha1));
+    std::filesystem::remove(fileName);
+
+    EXPECT_THROW(digestFile("non_existent_hash_file.bin"), neko::ex::FileError);
+}
+
+TEST_F(HashTest, BatchMultiAlgorithmDigest) {
+    using namespace neko::util::hash;
+    std::vector<std::string> paths;
+    for (int i = 0; i < 8; ++i) {
+        std::string fileName = "test_hash_batch_" + std::to_string(i) + ".bin";
+        std::ofstream file(fileName, std::ios::binary);
+        file << "content " << i;
+        paths.push_back(fileName);
+    }
+
+    auto results = digestFiles(paths, {Algorithm::sha1, Algorithm::sha256}, 3);
+    ASSERT_EQ(results.size(), paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        std::string content = "content " + std::to_string(i);
+        ASSERT_EQ(results[i].size(), 2u);
+        EXPECT_EQ(results[i][0], digest(content, Algorithm::sha1));
+        EXPECT_EQ(results[i][1], digest(content, Algorithm::sha256));
+    }
+
+    paths.push_back("non_existent_hash_file.bin");
+    EXPECT_THROW(digestFiles(paths, {Algorithm::md5}, 2), neko::ex::FileError);
+
+    for (const auto &p : paths) {
+        std::filesystem::remove(p);
+    }
+}
+
+TEST_F(HashTest, RawDigestAndHex) {
+    using namespace neko::util::hash;
+    Digest raw = digestRaw("test", Algorithm::sha256);
+    EXPECT_EQ(raw.size(), digestSize(Algorithm::sha256));
+    EXPECT_EQ(raw.hex(), digest("test", Algorithm::sha256));
+    EXPECT_TRUE(digestRaw("test", Algorithm::none).empty());
+
+    const std::uint8_t bytes[] = {0x00, 0x0f, 0xa5, 0xff};
+    char buf[8];
+    char *end = toHex(bytes, buf);
+    EXPECT_EQ(std::string(buf, end), "000fa5ff");
+}
+
+TEST_F(HashTest, UUIDv3Known) {
+    using namespace neko::util::uuid;
+    // RFC 4122 DNS namespace, name "www.example.com"
+    EXPECT_EQ(uuidV3("www.example.com"), "5df41881-3aed-3515-88a7-2f4a814cf09e");
+    EXPECT_EQ(Uuid::v3("www.example.com").toString(), "5df41881-3aed-3515-88a7-2f4a814cf09e");
+    EXPECT_EQ(Uuid::v3("www.example.com", namespaceDns).version(), 3);
+    EXPECT_EQ(uuidV5("www.example.com"), "2ed6657d-e927-568b-95e1-2665a8aea6a2");
+    EXPECT_EQ(Uuid::v5("www.example.com").version(), 5);
+}
+
+TEST_F(HashTest, AlgorithmMapping) {
+    using namespace neko::util::hash;
+    static_assert(mapAlgorithm("sha1") == Algorithm::sha1);
+    static_assert(algorithmName(Algorithm::sha512) == "sha512");
+    EXPECT_EQ(mapAlgorithm(std::string("md5")), Algorithm::md5);
+    EXPECT_EQ(mapAlgorithm("crc"), Algorithm::none);
+    EXPECT_EQ(mapAlgorithm(Algorithm::sha256), "sha256");
+    EXPECT_EQ(mapAlgorithm(Algorithm::none), "unknown");
+}
+
+TEST_F(HashTest, ContextReuseAcrossCalls) {
+    using namespace neko::util::hash;
+    // Pooled contexts must be fully reset between algorithms
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(digest("test", Algorithm::md5), "098f6bcd4621d373cade4e832627b4f6");
+        EXPECT_EQ(digest("test", Algorithm::sha256), "9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08");
+    }
+    std::thread worker([] {
+        EXPECT_EQ(digest("test", Algorithm::md5), "098f6bcd4621d373cade4e832627b4f6");
+    });
+    worker.join();
+}
+
 #endif // NEKO_FUNCTION_ENABLE_HASH
 
+// ============================================================================
+// Built-in Hash Algorithm Tests (no OpenSSL required)
+// ============================================================================
+
+class BuiltinHashTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(BuiltinHashTest, KnownVectors) {
+    using namespace neko::util::hash;
+    EXPECT_EQ(digest("123456789", Algorithm::crc32), "cbf43926");
+    EXPECT_EQ(digest("123456789", Algorithm::crc32c), "e3069283");
+    EXPECT_EQ(crc32("123456789", 9), 0xCBF43926u);
+    EXPECT_EQ(crc32c("123456789", 9), 0xE3069283u);
+    EXPECT_EQ(digest("", Algorithm::xxh3_64), "2d06800538d394c2");
+    EXPECT_EQ(digest("", Algorithm::xxh3_128), "99aa06d3014798d86001c324468d497f");
+    EXPECT_EQ(digest("", Algorithm::blake3), "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262");
+    EXPECT_EQ(digest("abc", Algorithm::blake3), "6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85");
+}
+
+TEST_F(BuiltinHashTest, ChunkedMatchesOneShot) {
+    using namespace neko::util::hash;
+    std::string data;
+    for (int i = 0; i < 5000; ++i) {
+        data.push_back(static_cast<char>(i % 251));
+    }
+    for (auto algorithm : {Algorithm::crc32, Algorithm::crc32c, Algorithm::xxh3_64, Algorithm::xxh3_128, Algorithm::blake3}) {
+        for (std::size_t len : {0, 3, 16, 128, 240, 241, 256, 1024, 1025, 5000}) {
+            std::string_view input(data.data(), len);
+            Hasher hasher(algorithm);
+            for (std::size_t offset = 0; offset < len; offset += 7) {
+                hasher.update(input.substr(offset, 7));
+            }
+            EXPECT_EQ(hasher.finalizeRaw(), digestRaw(input, algorithm)) << mapAlgorithm(algorithm) << " " << len;
+        }
+    }
+    // Official BLAKE3 test vectors use bytes i % 251
+    EXPECT_EQ(digest(std::string(data.data(), 1024), Algorithm::blake3), "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7");
+    EXPECT_EQ(digest(std::string(data.data(), 1025), Algorithm::blake3), "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444");
+}
+
+TEST_F(BuiltinHashTest, FileDigest) {
+    using namespace neko::util::hash;
+    const std::string path = "builtin_hash_test.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "123456789";
+    }
+    auto results = digestFile(path, {Algorithm::crc32, Algorithm::none, Algorithm::xxh3_64});
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0], "cbf43926");
+    EXPECT_TRUE(results[1].empty());
+    EXPECT_EQ(results[2], digest("123456789", Algorithm::xxh3_64));
+    EXPECT_EQ(digestSize(Algorithm::xxh3_128), 16u);
+    EXPECT_EQ(mapAlgorithm("xxh128"), Algorithm::xxh3_128);
+    EXPECT_TRUE(isSupported(Algorithm::blake3));
+    std::filesystem::remove(path);
+}
+
+// ============================================================================
+// Thread Pool Tests
+// ============================================================================
+
+namespace {
+    // Fire-and-forget coroutine, enough to drive schedule()
+    struct DetachedTask {
+        struct promise_type {
+            DetachedTask get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+    };
+
+    DetachedTask resumeOnPool(neko::util::pool::ThreadPool &pool, std::promise<bool> &resumedOnWorker) {
+        co_await pool.schedule();
+        resumedOnWorker.set_value(pool.isWorkerThread());
+    }
+} // namespace
+
+TEST(ThreadPoolTest, SubmitAndExceptions) {
+    using namespace neko::util::pool;
+    ThreadPool pool(2);
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_FALSE(pool.isWorkerThread());
+
+    auto value = pool.submit([] { return 21 * 2; });
+    auto failure = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_EQ(value.get(), 42);
+    EXPECT_THROW(failure.get(), std::runtime_error);
+
+    // Jobs posted from a worker land on its own deque and can be stolen by the other
+    auto nested = pool.submit([&pool] {
+        std::vector<std::future<int>> inner;
+        for (int i = 0; i < 16; ++i)
+            inner.push_back(pool.submit([i] { return i; }));
+        int sum = 0;
+        for (auto &f : inner)
+            sum += f.get();
+        return sum;
+    });
+    EXPECT_EQ(nested.get(), 120);
+
+    std::promise<bool> resumed;
+    auto resumedFuture = resumed.get_future();
+    resumeOnPool(pool, resumed);
+    EXPECT_TRUE(resumedFuture.get());
+}
+
+TEST(ThreadPoolTest, TaskGroupAndRunWorkers) {
+    using namespace neko::util::pool;
+    ThreadPool pool(1);
+
+    // The only worker is busy, so the group's job never starts and wait() skips it
+    std::promise<void> busy, release;
+    auto blocker = pool.submit([&busy, future = release.get_future().share()] {
+        busy.set_value();
+        future.wait();
+    });
+    busy.get_future().wait();
+    bool ran = false;
+    {
+        TaskGroup group(pool);
+        group.run([&ran] { ran = true; });
+        group.wait();
+    }
+    release.set_value();
+    blocker.get();
+    EXPECT_FALSE(ran);
+
+    {
+        std::promise<void> started;
+        TaskGroup group(pool);
+        group.run([&started] {
+            started.set_value();
+            throw std::runtime_error("group");
+        });
+        started.get_future().wait();
+        EXPECT_THROW(group.wait(), std::runtime_error);
+    }
+
+    std::atomic<int> next{0};
+    std::vector<int> seen(1000, 0);
+    runWorkers(4, [&](std::size_t) {
+        for (int i = next++; i < 1000; i = next++)
+            ++seen[i];
+    }, pool);
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](int count) { return count == 1; }));
+    EXPECT_THROW(runWorkers(3, [](std::size_t worker) {
+        if (worker == 0)
+            throw std::logic_error("caller");
+    }, pool), std::logic_error);
+
+    // Once the default pool exists its size is fixed
+    const auto defaultSize = defaultPool().size();
+    EXPECT_FALSE(setDefaultPoolSize(defaultSize + 1));
+    EXPECT_EQ(defaultPool().size(), defaultSize);
+
+    // Nested parallel work from a pool thread finishes even when every worker is occupied
+    auto nested = pool.submit([] {
+        std::vector<int> values(500);
+        std::iota(values.begin(), values.end(), 0);
+        using namespace neko::ops::pipeline;
+        auto squares = values | parallel(4) | map([](int x) { return x * x; }) | collect();
+        return squares.back();
+    });
+    EXPECT_EQ(nested.get(), 499 * 499);
+}
+
+TEST_F(BuiltinHashTest, DigestFileAsync) {
+    using namespace neko::util::hash;
+    const std::string path = "builtin_hash_async.bin";
+    std::ofstream(path, std::ios::binary) << "123456789";
+    auto digestFuture = digestFileAsync(path, Algorithm::crc32);
+    auto missing = digestFileAsync("missing_builtin_hash_async.bin", Algorithm::crc32);
+    EXPECT_EQ(digestFuture.get(), "cbf43926");
+    EXPECT_THROW(missing.get(), neko::ex::FileError);
+    std::filesystem::remove(path);
+}
+
+// ============================================================================
+// Profiling Hook Tests
+// ============================================================================
+
+TEST(ProfileTest, ProbeCountsBytesAndHistogram) {
+    using namespace neko::util::profile;
+    static Probe probe("test.probe");
+    probe.reset();
+    probe.record(100, std::chrono::nanoseconds(1));
+    probe.record(50, std::chrono::nanoseconds(1000));
+    { ScopedTimer timer(probe); timer.addBytes(7); }
+
+    auto stats = probe.stats();
+    EXPECT_EQ(stats.name, "test.probe");
+    EXPECT_EQ(stats.calls, 3u);
+    EXPECT_EQ(stats.bytes, 157u);
+    EXPECT_GE(stats.max, std::chrono::nanoseconds(1000));
+    EXPECT_EQ(stats.histogram[0], 1u);  // [0, 2) ns
+    EXPECT_GE(stats.histogram[9], 1u);  // [512, 1024) ns
+    EXPECT_LE(stats.percentile(0.3), std::chrono::nanoseconds(2));
+    EXPECT_EQ(stats.percentile(1.0), stats.max);
+
+    auto all = snapshot();
+    EXPECT_TRUE(std::any_of(all.begin(), all.end(), [](const ProbeStats &s) { return s.name == "test.probe"; }));
+
+    std::vector<std::uint64_t> forwarded;
+    setSink([&](const Event &event) {
+        if (event.name == "test.probe")
+            forwarded.push_back(event.bytes);
+        throw std::runtime_error("ignored");
+    });
+    probe.record(42, std::chrono::nanoseconds(5));
+    setSink({});
+    probe.record(43, std::chrono::nanoseconds(5));
+    EXPECT_EQ(forwarded, std::vector<std::uint64_t>{42});
+
+    reset();
+    EXPECT_EQ(probe.stats().calls, 0u);
+}
+
+#ifdef NEKO_FUNCTION_ENABLE_PROFILING
+TEST(ProfileTest, HotPathsReportWhenEnabled) {
+    using namespace neko::util;
+    profile::reset();
+    hash::digest(std::string(1000, 'x'), hash::Algorithm::crc32);
+    pattern::matchAny("logs/app.log", {"*.log"});
+
+    auto find = [](std::string_view name) {
+        for (const auto &stats : profile::snapshot())
+            if (stats.name == name)
+                return stats;
+        return profile::ProbeStats{};
+    };
+    EXPECT_EQ(find("hash.digest").calls, 1u);
+    EXPECT_EQ(find("hash.digest").bytes, 1000u);
+    EXPECT_EQ(find("pattern.matchAny").calls, 1u);
+#if defined(__linux__)
+    // A stream reports size 0, so the bytes are counted as they are read
+    // Both digestFile overloads report under this name, each through its own probe
+    hash::digestFile("/proc/self/status", hash::Algorithm::crc32);
+    std::uint64_t streamed = 0;
+    for (const auto &stats : profile::snapshot())
+        if (stats.name == "hash.digestFile")
+            streamed += stats.bytes;
+    EXPECT_GT(streamed, 0u);
+#endif
+}
+#endif
+
 // ============================================================================
 // Archiver Tests (conditional compilation)
 // ============================================================================
@@ -346,9 +1424,12 @@ TEST_F(ArchiverTest, ZIPDetection) {
     
     // Test detection on existing file
     EXPECT_TRUE(zip::isZipArchiveFile(zipFile));
-    
-    // Note: isZipArchiveFile may throw exception for non-existent files
-    // so we skip testing with non-existent file
+    EXPECT_TRUE(isArchiveFile(zipFile));
+    EXPECT_FALSE(isArchiveFile(testDir + "/" + testFile));
+
+    // Missing files throw, as detectFileType does
+    EXPECT_THROW(zip::isZipArchiveFile("missing_archive.zip"), neko::ex::FileError);
+    EXPECT_THROW(isArchiveFile("missing_archive.zip"), neko::ex::FileError);
 }
 
 TEST_F(ArchiverTest, ExtractArchive) {
@@ -383,6 +1464,404 @@ TEST_F(ArchiverTest, ExtractArchive) {
     std::filesystem::remove_all(extractDir);
 }
 
+TEST_F(ArchiverTest, ParallelExtractArchive) {
+    using namespace neko::archive;
+
+    const std::string extractDir = "test_parallel_extract_dir";
+    for (int i = 0; i < 32; ++i) {
+        std::filesystem::create_directories(testDir + "/sub" + std::to_string(i % 4));
+        std::ofstream(testDir + "/sub" + std::to_string(i % 4) + "/file" + std::to_string(i) + ".txt") << std::string(i * 100, 'a' + i % 26);
+    }
+
+    CreateConfig createConfig;
+    createConfig.outputArchivePath = zipFile;
+    createConfig.inputPaths = {testDir + "/"};
+    zip::create(createConfig);
+
+    std::filesystem::remove_all(extractDir);
+    ExtractConfig extractConfig;
+    extractConfig.inputArchivePath = zipFile;
+    extractConfig.destDir = extractDir;
+    extractConfig.threads = 4;
+    extractConfig.excludePaths = {"file3.txt"};
+    EXPECT_NO_THROW(zip::extract(extractConfig));
+
+    for (int i = 0; i < 32; ++i) {
+        auto path = std::filesystem::path(extractDir) / testDir / ("sub" + std::to_string(i % 4)) / ("file" + std::to_string(i) + ".txt");
+        if (i == 3) {
+            EXPECT_FALSE(std::filesystem::exists(path));
+            continue;
+        }
+        ASSERT_TRUE(std::filesystem::exists(path)) << path;
+        EXPECT_EQ(std::filesystem::file_size(path), static_cast<std::uintmax_t>(i * 100));
+    }
+    EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(extractDir) / testDir / testFile));
+
+    std::filesystem::remove_all(extractDir);
+}
+
+TEST_F(ArchiverTest, CompressionLevelAndParallelCreate) {
+    using namespace neko::archive;
+
+    const std::string extractDir = "test_parallel_create_dir";
+    for (int i = 0; i < 24; ++i) {
+        std::filesystem::create_directories(testDir + "/sub" + std::to_string(i % 3));
+        std::ofstream(testDir + "/sub" + std::to_string(i % 3) + "/file" + std::to_string(i) + ".txt") << std::string(4096 + i * 100, 'a' + i % 26);
+    }
+    // PNG signature, stored rather than deflated
+    std::ofstream(testDir + "/image.png", std::ios::binary) << std::string("\x89PNG\r\n\x1a\n", 8) << std::string(2048, 'p');
+
+    CreateConfig storeConfig;
+    storeConfig.outputArchivePath = "test_store.zip";
+    storeConfig.inputPaths = {testDir + "/"};
+    storeConfig.compressionLevel = CompressionLevel::none;
+    EXPECT_NO_THROW(zip::create(storeConfig));
+
+    CreateConfig parallelConfig = storeConfig;
+    parallelConfig.outputArchivePath = zipFile;
+    parallelConfig.compressionLevel = CompressionLevel::maximum;
+    parallelConfig.threads = 4;
+    EXPECT_NO_THROW(zip::create(parallelConfig));
+    EXPECT_LT(std::filesystem::file_size(zipFile), std::filesystem::file_size("test_store.zip"));
+
+    std::filesystem::remove_all(extractDir);
+    ExtractConfig extractConfig;
+    extractConfig.inputArchivePath = zipFile;
+    extractConfig.destDir = extractDir;
+    EXPECT_NO_THROW(zip::extract(extractConfig));
+
+    for (int i = 0; i < 24; ++i) {
+        auto path = std::filesystem::path(extractDir) / testDir / ("sub" + std::to_string(i % 3)) / ("file" + std::to_string(i) + ".txt");
+        ASSERT_TRUE(std::filesystem::exists(path)) << path;
+        EXPECT_EQ(std::filesystem::file_size(path), static_cast<std::uintmax_t>(4096 + i * 100));
+    }
+    EXPECT_EQ(std::filesystem::file_size(std::filesystem::path(extractDir) / testDir / "image.png"), 2056u);
+
+    std::filesystem::remove_all(extractDir);
+    std::filesystem::remove("test_store.zip");
+}
+
+TEST_F(ArchiverTest, DirectoryWildcardFiltersCoverSubtree) {
+    using namespace neko::archive;
+
+    std::filesystem::create_directories(testDir + "/keep");
+    std::filesystem::create_directories(testDir + "/skip/nested");
+    std::ofstream(testDir + "/keep/a.txt") << "a";
+    std::ofstream(testDir + "/skip/b.txt") << "b";
+    std::ofstream(testDir + "/skip/nested/c.txt") << "c";
+
+    // Archive filters default to WildcardMode::legacy, where "skip/*" excludes the whole subtree
+    CreateConfig config;
+    config.outputArchivePath = zipFile;
+    config.inputPaths = {testDir + "/"};
+    config.excludePaths = {"skip/*"};
+    zip::create(config);
+
+    zip::ZipIndex index(zipFile);
+    EXPECT_NE(index.find(testDir + "/keep/a.txt"), nullptr);
+    for (const auto &entry : index.entries())
+        EXPECT_EQ(entry.name.find("/skip/"), std::string::npos) << entry.name;
+
+    ExtractConfig extractConfig;
+    extractConfig.inputArchivePath = zipFile;
+    extractConfig.includePaths = {"keep/*"};
+    std::ifstream in(zipFile, std::ios::binary);
+    std::vector<neko::uchar> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    auto entries = zip::extractToMemory(bytes, extractConfig);
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].name, testDir + "/keep/a.txt");
+
+    // Glob mode is opt-in and adds '**' and '?'
+    extractConfig.wildcardMode = neko::util::pattern::WildcardMode::glob;
+    extractConfig.includePaths = {testDir + "/**/?.txt"};
+    entries = zip::extractToMemory(bytes, extractConfig);
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].name, testDir + "/keep/a.txt");
+}
+
+TEST_F(ArchiverTest, ExtractNonAsciiNames) {
+    using namespace neko::archive;
+
+    // Entry names are stored as UTF-8, and must reach the same file names on every platform
+    const std::u8string name = u8"d\u00e9p\u00f4t/\u65e5\u672c\u8a9e.txt";
+    const std::string content = "unicode";
+    std::vector<MemoryFile> files = {
+        {std::string(name.begin(), name.end()), std::span<const neko::uchar>(reinterpret_cast<const neko::uchar *>(content.data()), content.size())}};
+    const auto archive = zip::create(files, {});
+    std::ofstream(zipFile, std::ios::binary).write(reinterpret_cast<const char *>(archive.data()), static_cast<std::streamsize>(archive.size()));
+
+    const std::string extractDir = "test_unicode_extract_dir";
+    for (std::size_t threads : {1u, 2u}) {
+        std::filesystem::remove_all(extractDir);
+        ExtractConfig config;
+        config.inputArchivePath = zipFile;
+        config.destDir = extractDir;
+        config.threads = threads;
+        EXPECT_EQ(zip::extract(config).entries, 1u);
+        const auto path = std::filesystem::path(extractDir) / std::filesystem::path(name);
+        ASSERT_TRUE(std::filesystem::exists(path)) << threads << " threads";
+        EXPECT_EQ(std::filesystem::file_size(path), content.size());
+    }
+    std::filesystem::remove_all(extractDir);
+}
+
+TEST_F(ArchiverTest, AsyncCreateAndExtract) {
+    using namespace neko::archive;
+
+    const std::string extractDir = "test_async_extract_dir";
+    std::filesystem::remove_all(extractDir);
+    std::future<ArchiveSummary> created;
+    {
+        CreateConfig config;
+        config.outputArchivePath = zipFile;
+        config.inputPaths = {testDir + "/"};
+        config.threads = 2;
+        created = zip::createAsync(config);
+    }
+    EXPECT_GE(created.get().entries, 1u);
+
+    ExtractConfig config;
+    config.inputArchivePath = zipFile;
+    config.destDir = extractDir;
+    auto extracted = zip::extractAsync(config);
+    EXPECT_GE(extracted.get().entries, 1u);
+    EXPECT_TRUE(std::filesystem::exists(std::filesystem::path(extractDir) / testDir / testFile));
+
+    config.inputArchivePath = "missing_async.zip";
+    EXPECT_THROW(zip::extractAsync(config).get(), neko::ex::FileError);
+    std::filesystem::remove_all(extractDir);
+}
+
+TEST_F(ArchiverTest, InMemoryRoundTrip) {
+    using namespace neko::archive;
+
+    const std::string text(10000, 'x');
+    const std::vector<neko::uchar> binary = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A, 1, 2, 3};
+    std::vector<MemoryFile> files = {
+        {"docs/readme.txt", std::span<const neko::uchar>(reinterpret_cast<const neko::uchar *>(text.data()), text.size())},
+        {"img/logo.png", binary},
+        {"empty.txt", {}}};
+
+    CreateConfig createConfig;
+    createConfig.password = "secret";
+    std::vector<neko::uchar> archive;
+    ASSERT_NO_THROW(archive = zip::create(files, createConfig));
+    ASSERT_FALSE(archive.empty());
+
+    ExtractConfig extractConfig;
+    extractConfig.password = "secret";
+    auto entries = zip::extractToMemory(archive, extractConfig);
+    ASSERT_EQ(entries.size(), 3u);
+    EXPECT_EQ(entries[0].name, "docs/readme.txt");
+    EXPECT_EQ(std::string(entries[0].data.begin(), entries[0].data.end()), text);
+    EXPECT_EQ(entries[1].data, binary);
+    EXPECT_TRUE(entries[2].data.empty());
+
+    // Callback source and sink, with a filter
+    std::size_t offset = 0;
+    auto read = [&](neko::uchar *buffer, std::size_t size) {
+        std::size_t n = std::min(size, archive.size() - offset);
+        std::copy_n(archive.data() + offset, n, buffer);
+        offset += n;
+        return n;
+    };
+    std::size_t total = 0;
+    extractConfig.includePaths = {"*.txt"};
+    zip::extract(read, extractConfig, [&](std::string_view name, std::span<const neko::uchar> chunk) {
+        EXPECT_TRUE(name.ends_with(".txt"));
+        total += chunk.size();
+    });
+    EXPECT_EQ(total, text.size());
+}
+
+TEST_F(ArchiverTest, ZipIndexLookupAndRead) {
+    using namespace neko::archive;
+
+    std::vector<std::string> contents;
+    for (int i = 0; i < 16; ++i) {
+        contents.push_back(std::string(1000 + i * 37, 'a' + i));
+    }
+    std::vector<MemoryFile> files;
+    for (int i = 0; i < 16; ++i) {
+        files.push_back({"assets/" + std::to_string(15 - i) + ".bin",
+                         std::span<const neko::uchar>(reinterpret_cast<const neko::uchar *>(contents[i].data()), contents[i].size())});
+    }
+    auto archive = zip::create(files);
+    std::ofstream(zipFile, std::ios::binary).write(reinterpret_cast<const char *>(archive.data()), static_cast<std::streamsize>(archive.size()));
+
+    zip::ZipIndex index(zipFile);
+    ASSERT_EQ(index.size(), 16u);
+    EXPECT_TRUE(std::is_sorted(index.entries().begin(), index.entries().end(),
+                               [](const auto &a, const auto &b) { return a.name < b.name; }));
+    EXPECT_EQ(index.find("assets/missing.bin"), nullptr);
+
+    const auto *entry = index.find("assets/15.bin");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->uncompressedSize, static_cast<std::int64_t>(contents[0].size()));
+    EXPECT_FALSE(entry->isDirectory());
+    auto data = index.read(*entry);
+    EXPECT_EQ(std::string(data.begin(), data.end()), contents[0]);
+    EXPECT_THROW(index.read("assets/missing.bin"), neko::ex::FileError);
+
+    // Concurrent reads share the index
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t] {
+            for (int i = t; i < 16; i += 4) {
+                auto bytes = index.read("assets/" + std::to_string(15 - i) + ".bin");
+                if (std::string(bytes.begin(), bytes.end()) != contents[i])
+                    ++mismatches;
+            }
+        });
+    }
+    for (auto &th : readers) {
+        th.join();
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+TEST_F(ArchiverTest, IncrementalCreate) {
+    using namespace neko::archive;
+
+    for (int i = 0; i < 8; ++i) {
+        std::ofstream(testDir + "/inc" + std::to_string(i) + ".txt") << std::string(2000, 'a' + i);
+    }
+
+    CreateConfig createConfig;
+    createConfig.outputArchivePath = zipFile;
+    createConfig.inputPaths = {testDir + "/"};
+    createConfig.incremental = true;
+    ASSERT_NO_THROW(zip::create(createConfig));
+    ASSERT_TRUE(std::filesystem::exists(zipFile + ".manifest"));
+
+    // Change one file, touch another without changing it, add a third
+    std::ofstream(testDir + "/inc2.txt") << std::string(2000, 'z');
+    std::filesystem::last_write_time(testDir + "/inc5.txt", std::filesystem::file_time_type::clock::now() + std::chrono::hours(1));
+    std::ofstream(testDir + "/new.txt") << "new";
+    ASSERT_NO_THROW(zip::create(createConfig));
+
+    zip::ZipIndex index(zipFile);
+    auto inc2 = index.read(testDir + "/inc2.txt");
+    EXPECT_EQ(std::string(inc2.begin(), inc2.end()), std::string(2000, 'z'));
+    auto inc5 = index.read(testDir + "/inc5.txt");
+    EXPECT_EQ(std::string(inc5.begin(), inc5.end()), std::string(2000, 'f'));
+    auto added = index.read(testDir + "/new.txt");
+    EXPECT_EQ(std::string(added.begin(), added.end()), "new");
+
+    std::ifstream manifest(zipFile + ".manifest");
+    std::string line;
+    std::size_t lines = 0;
+    while (std::getline(manifest, line)) {
+        ++lines;
+    }
+    EXPECT_EQ(lines, index.size() + 1);
+    std::filesystem::remove(zipFile + ".manifest");
+}
+
+TEST_F(ArchiverTest, OverwriteIfChanged) {
+    using namespace neko::archive;
+
+    const std::string extractDir = "test_if_changed_dir";
+    std::ofstream(testDir + "/same.txt") << std::string(3000, 's');
+    std::ofstream(testDir + "/edited.txt") << std::string(3000, 'e');
+
+    CreateConfig createConfig;
+    createConfig.outputArchivePath = zipFile;
+    createConfig.inputPaths = {testDir + "/"};
+    zip::create(createConfig);
+
+    std::filesystem::remove_all(extractDir);
+    ExtractConfig extractConfig;
+    extractConfig.inputArchivePath = zipFile;
+    extractConfig.destDir = extractDir;
+    zip::extract(extractConfig);
+
+    const auto same = std::filesystem::path(extractDir) / testDir / "same.txt";
+    const auto edited = std::filesystem::path(extractDir) / testDir / "edited.txt";
+    // Same size, different content, and a marker time on the untouched file
+    std::ofstream(edited) << std::string(3000, 'x');
+    const auto marker = std::filesystem::file_time_type::clock::now() - std::chrono::hours(48);
+    std::filesystem::last_write_time(same, marker);
+
+    for (std::size_t threads : {std::size_t(1), std::size_t(4)}) {
+        extractConfig.overwrite = OverwritePolicy::ifChanged;
+        extractConfig.threads = threads;
+        EXPECT_NO_THROW(zip::extract(extractConfig));
+        EXPECT_EQ(std::filesystem::last_write_time(same), marker);
+        std::ifstream in(edited);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        EXPECT_EQ(content, std::string(3000, 'e'));
+        std::ofstream(edited) << std::string(3000, 'x');
+    }
+
+    // The former bool field still compiles and maps onto the policies
+    extractConfig.overwrite = true;
+    EXPECT_EQ(extractConfig.overwrite, OverwritePolicy::always);
+    extractConfig.overwrite = false;
+    EXPECT_EQ(extractConfig.overwrite.policy(), OverwritePolicy::never);
+    EXPECT_FALSE(extractConfig.overwrite);
+    extractConfig.threads = 1;
+    EXPECT_NO_THROW(zip::extract(extractConfig));
+    std::ifstream in(edited);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, std::string(3000, 'x'));
+
+    std::filesystem::remove_all(extractDir);
+}
+
+TEST_F(ArchiverTest, ObserverSummaryAndCancel) {
+    using namespace neko::archive;
+
+    const std::string extractDir = "test_observer_dir";
+    for (int i = 0; i < 10; ++i) {
+        std::ofstream(testDir + "/obs" + std::to_string(i) + ".txt") << std::string(5000, 'o');
+    }
+
+    std::size_t started = 0, finished = 0;
+    CreateConfig createConfig;
+    createConfig.outputArchivePath = zipFile;
+    createConfig.inputPaths = {testDir + "/"};
+    createConfig.observer.onEntryStart = [&](const EntryEvent &) { ++started; return true; };
+    createConfig.observer.onEntryFinish = [&](const EntryEvent &event) {
+        ++finished;
+        EXPECT_GT(event.compressedSize, 0);
+        return true;
+    };
+    auto created = zip::create(createConfig);
+    EXPECT_FALSE(created.cancelled);
+    EXPECT_EQ(started, finished);
+    EXPECT_EQ(created.entries, finished);
+    EXPECT_GE(created.uncompressedBytes, 50000u);
+
+    std::filesystem::remove_all(extractDir);
+    ExtractConfig extractConfig;
+    extractConfig.inputArchivePath = zipFile;
+    extractConfig.destDir = extractDir;
+    auto extracted = zip::extract(extractConfig);
+    EXPECT_EQ(extracted.entries, created.entries);
+    EXPECT_EQ(extracted.uncompressedBytes, created.uncompressedBytes);
+    EXPECT_GT(extracted.bytesPerSecond(), 0.0);
+
+    // Stop after three entries
+    std::filesystem::remove_all(extractDir);
+    std::size_t count = 0;
+    extractConfig.observer.onEntryFinish = [&](const EntryEvent &) { return ++count < 3; };
+    auto cancelled = zip::extract(extractConfig);
+    EXPECT_TRUE(cancelled.cancelled);
+    EXPECT_EQ(cancelled.entries, 3u);
+
+    // A stop requested up front writes nothing
+    std::stop_source source;
+    source.request_stop();
+    createConfig.outputArchivePath = "test_cancelled.zip";
+    createConfig.stopToken = source.get_token();
+    EXPECT_TRUE(zip::create(createConfig).cancelled);
+    EXPECT_FALSE(std::filesystem::exists("test_cancelled.zip"));
+
+    std::filesystem::remove_all(extractDir);
+}
+
 #endif // NEKO_FUNCTION_ENABLE_ARCHIVE
 
 // ============================================================================